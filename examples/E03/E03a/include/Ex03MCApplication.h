@@ -26,9 +26,12 @@
 #include <TMCVerbose.h>
 
 class Ex03MCStack;
+class Ex03MCCompactStack;
 class Ex03PrimaryGenerator;
 
 class TVirtualMCRootManager;
+class TVirtualMCStack;
+class TParticle;
 
 /// \ingroup E03a
 /// \brief Implementation of the TVirtualMCApplication
@@ -79,11 +82,15 @@ class Ex03MCApplication : public TVirtualMCApplication
 
     // method for tests
     void SetOldGeometry(Bool_t oldGeometry = kTRUE);
+    void SetCheckStack(Bool_t checkStack = kTRUE);
+    void SetCompactStack(Bool_t compactStack = kTRUE);
+    TVirtualMCStack* GetMCStack() const;
  
   private:
     // methods
     Ex03MCApplication(const Ex03MCApplication& origin);
     void RegisterStack() const;
+    TParticle* GetParticle(Int_t id) const;
   
     // data members
     mutable TVirtualMCRootManager* fRootManager;//!< Root manager
@@ -91,6 +98,7 @@ class Ex03MCApplication : public TVirtualMCApplication
     Int_t                     fEventNo;         ///< Event counter
     TMCVerbose                fVerbose;         ///< VMC verbose helper
     Ex03MCStack*              fStack;           ///< VMC stack
+    Ex03MCCompactStack*       fCompactStack;    //!< VMC stack with particles in columns (if activated)
     Ex03DetectorConstruction* fDetConstruction; ///< Dector construction
     Ex03CalorimeterSD*        fCalorimeterSD;   ///< Calorimeter SD
     Ex03PrimaryGenerator*     fPrimaryGenerator;///< Primary generator
@@ -98,8 +106,9 @@ class Ex03MCApplication : public TVirtualMCApplication
     Bool_t                    fOldGeometry;     ///< Option for geometry definition
     Bool_t                    fIsControls;      ///< Option to activate special controls
     Bool_t                    fIsMaster;        ///< If is on master thread
+    Bool_t                    fCheckStack;      ///< Option to check the stack consistency
 
-  ClassDef(Ex03MCApplication,1)  //Interface to MonteCarlo application
+  ClassDef(Ex03MCApplication,3)  //Interface to MonteCarlo application
 };
 
 // inline functions
@@ -136,6 +145,11 @@ inline Ex03PrimaryGenerator* Ex03MCApplication::GetPrimaryGenerator() const
 inline void Ex03MCApplication::SetOldGeometry(Bool_t oldGeometry)
 { fOldGeometry = oldGeometry; }
 
+/// Switch on/off the check of the stack mother indices at the end of event
+/// \param checkStack  If true, the stack consistency is checked
+inline void Ex03MCApplication::SetCheckStack(Bool_t checkStack)
+{ fCheckStack = checkStack; }
+
 /// Switch on/off special process controls
 /// \param isControls  If true, special process controls setting is activated
 inline void Ex03MCApplication::SetControls(Bool_t isControls)
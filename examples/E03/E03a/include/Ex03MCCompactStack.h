@@ -0,0 +1,143 @@
+#ifndef EX03_COMPACT_STACK_H
+#define EX03_COMPACT_STACK_H
+
+//------------------------------------------------
+// The Virtual Monte Carlo examples
+// Copyright (C) 2014 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file  E03/include/Ex03MCCompactStack.h
+/// \brief Definition of the Ex03MCCompactStack class 
+///
+/// Geant4 ExampleN03 adapted to Virtual Monte Carlo
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <TVirtualMCStack.h>
+#include <TVirtualMCStackWithKeepFlag.h>
+
+#include <vector>
+
+class TParticle;
+
+/// \ingroup E03a
+/// \brief Implementation of the TVirtualMCStack interface with particles
+/// properties kept in contiguous columns
+///
+/// Unlike Ex03MCStack, which keeps each particle as a TParticle object, 
+/// the particle properties are stored in separate arrays (columns) 
+/// indexed by the track number, and the pending tracks are kept as 
+/// track numbers. The arrays are not cleared at the end of event, 
+/// they are reused in the next event.
+///
+/// TParticle objects are created only when a particle is requested
+/// (GetParticle(), GetCurrentTrack(), PopNextTrack(), PopPrimaryForTracking());
+/// they are filled in a small ring of kNofViews objects, so the returned 
+/// pointer is valid only until kNofViews further particle requests.
+///
+/// The stack is transient, it is not written in the output file.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class Ex03MCCompactStack : public TVirtualMCStack,
+                           public TVirtualMCStackWithKeepFlag
+{
+  public:
+    Ex03MCCompactStack(Int_t size);
+    Ex03MCCompactStack();
+    virtual ~Ex03MCCompactStack();     
+
+    // methods
+    virtual void  PushTrack(Int_t toBeDone, Int_t parent, Int_t pdg,
+  	              Double_t px, Double_t py, Double_t pz, Double_t e,
+  		      Double_t vx, Double_t vy, Double_t vz, Double_t tof,
+		      Double_t polx, Double_t poly, Double_t polz,
+		      TMCProcess mech, Int_t& ntr, Double_t weight,
+		      Int_t is) ;
+    virtual void  OverwriteLastTrack(Int_t toBeDone, Int_t parent, Int_t pdg,
+  	              Double_t px, Double_t py, Double_t pz, Double_t e,
+  		      Double_t vx, Double_t vy, Double_t vz, Double_t tof,
+		      Double_t polx, Double_t poly, Double_t polz,
+		      TMCProcess mech, Int_t& ntr, Double_t weight,
+		      Int_t is) ;
+    virtual TParticle* PopNextTrack(Int_t& track);
+    virtual TParticle* PopPrimaryForTracking(Int_t i); 
+    virtual void Print(Option_t* option = "") const;   
+    void Reset();   
+    Bool_t CheckMotherIndices() const;
+   
+    // set methods
+    virtual void  SetCurrentTrack(Int_t track);                           
+    virtual void  SetKeepCurrentTrack(Bool_t keep);
+
+    // get methods
+    virtual Int_t  GetNtrack() const;
+    virtual Int_t  GetNprimary() const;
+    virtual TParticle* GetCurrentTrack() const;   
+    virtual Int_t  GetCurrentTrackNumber() const;
+    virtual Int_t  GetCurrentParentTrackNumber() const;
+    TParticle*     GetParticle(Int_t id) const;
+    virtual Bool_t GetKeepCurrentTrack() const;
+    Int_t          GetPdg(Int_t id) const;
+    Int_t          GetMother(Int_t id) const;
+    Double_t       GetTime(Int_t id) const;
+    ULong_t        GetNofBytes() const;
+    
+  private:
+    /// The number of TParticle views
+    static const Int_t kNofViews = 8;
+
+    /// Not implemented
+    Ex03MCCompactStack(const Ex03MCCompactStack& right);
+    /// Not implemented
+    Ex03MCCompactStack& operator=(const Ex03MCCompactStack& right);
+
+    // methods
+    void  SetTrack(Int_t trackId, Int_t parent, Int_t pdg,
+  	           Double_t px, Double_t py, Double_t pz, Double_t e,
+  		   Double_t vx, Double_t vy, Double_t vz, Double_t tof,
+		   Double_t polx, Double_t poly, Double_t polz,
+		   TMCProcess mech, Double_t weight, Int_t is);
+
+    // data members
+    Int_t                  fNtrack;      ///< The number of tracks
+    std::vector<Int_t>     fPdg;         ///< The PDG encoding
+    std::vector<Int_t>     fMother;      ///< The mother track number
+    std::vector<Int_t>     fStatus;      ///< The generation status code
+    std::vector<Int_t>     fProcess;     ///< The creator process VMC code
+    std::vector<Double_t>  fMomentum;    ///< The 4-momentum (px, py, pz, e)
+    std::vector<Double_t>  fVertex;      ///< The vertex (vx, vy, vz, tof)
+    std::vector<Float_t>   fPolarization;///< The polarization (x, y, z)
+    std::vector<Double_t>  fWeight;      ///< The weight
+    std::vector<Int_t>     fPending;     ///< The track numbers to be done
+    Int_t                  fCurrentTrack;///< The current track number
+    Int_t                  fNPrimary;    ///< The number of primaries
+    Bool_t                 fKeepCurrentTrack; ///< The keep flag of the current track
+    mutable TParticle*     fViews[kNofViews]; ///< The TParticle views
+    mutable Int_t          fNextView;    ///< The index of the next view
+    
+    ClassDef(Ex03MCCompactStack,0) // Ex03MCCompactStack
+};
+
+// inline functions
+
+/// \return    The PDG encoding of the \em id -th particle
+/// \param id  The index of the particle
+inline Int_t Ex03MCCompactStack::GetPdg(Int_t id) const
+{ return fPdg[id]; }
+
+/// \return    The mother track number of the \em id -th particle
+/// \param id  The index of the particle
+inline Int_t Ex03MCCompactStack::GetMother(Int_t id) const
+{ return fMother[id]; }
+
+/// \return    The production time of the \em id -th particle
+/// \param id  The index of the particle
+inline Double_t Ex03MCCompactStack::GetTime(Int_t id) const
+{ return fVertex[4*id+3]; }
+
+#endif //EX03_COMPACT_STACK_H   
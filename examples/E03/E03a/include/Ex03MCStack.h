@@ -18,6 +18,7 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include <TVirtualMCStack.h>
+#include <TVirtualMCStackWithKeepFlag.h>
 
 #include <stack>
 
@@ -27,10 +28,15 @@ class TClonesArray;
 /// \ingroup E03a
 /// \brief Implementation of the TVirtualMCStack interface
 ///
+/// The stack implements also the TVirtualMCStackWithKeepFlag interface
+/// and so it can be used with the overwriting of tracks activated
+/// in the MC.
+///
 /// \date 06/03/2003
 /// \author I. Hrivnacova; IPN, Orsay
 
-class Ex03MCStack : public TVirtualMCStack
+class Ex03MCStack : public TVirtualMCStack,
+                    public TVirtualMCStackWithKeepFlag
 {
   public:
     Ex03MCStack(Int_t size);
@@ -44,13 +50,21 @@ class Ex03MCStack : public TVirtualMCStack
 		      Double_t polx, Double_t poly, Double_t polz,
 		      TMCProcess mech, Int_t& ntr, Double_t weight,
 		      Int_t is) ;
+    virtual void  OverwriteLastTrack(Int_t toBeDone, Int_t parent, Int_t pdg,
+  	              Double_t px, Double_t py, Double_t pz, Double_t e,
+  		      Double_t vx, Double_t vy, Double_t vz, Double_t tof,
+		      Double_t polx, Double_t poly, Double_t polz,
+		      TMCProcess mech, Int_t& ntr, Double_t weight,
+		      Int_t is) ;
     virtual TParticle* PopNextTrack(Int_t& track);
     virtual TParticle* PopPrimaryForTracking(Int_t i); 
     virtual void Print(Option_t* option = "") const;   
     void Reset();   
+    Bool_t CheckMotherIndices() const;
    
     // set methods
     virtual void  SetCurrentTrack(Int_t track);                           
+    virtual void  SetKeepCurrentTrack(Bool_t keep);
 
     // get methods
     virtual Int_t  GetNtrack() const;
@@ -59,6 +73,9 @@ class Ex03MCStack : public TVirtualMCStack
     virtual Int_t  GetCurrentTrackNumber() const;
     virtual Int_t  GetCurrentParentTrackNumber() const;
     TParticle*     GetParticle(Int_t id) const;
+    virtual Bool_t GetKeepCurrentTrack() const;
+    Int_t          GetNofPushedTracks() const;
+    Int_t          GetNofOverwrittenTracks() const;
     
   private:
     // data members
@@ -66,8 +83,11 @@ class Ex03MCStack : public TVirtualMCStack
     TClonesArray*           fParticles;   ///< The array of particle (persistent)
     Int_t                   fCurrentTrack;///< The current track number
     Int_t                   fNPrimary;    ///< The number of primaries
+    Bool_t                  fKeepCurrentTrack; //!< The keep flag of the current track (transient)
+    Int_t                   fNofPushedTracks; //!< The number of pushed tracks (transient)
+    Int_t                   fNofOverwrittenTracks; //!< The number of overwritten tracks (transient)
     
-    ClassDef(Ex03MCStack,1) // Ex03MCStack
+    ClassDef(Ex03MCStack,2) // Ex03MCStack
 };
 
 #endif //EX03_STACK_H   
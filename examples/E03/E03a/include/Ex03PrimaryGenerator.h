@@ -58,6 +58,7 @@ class Ex03PrimaryGenerator : public TObject
     void  SetIsRandom(Bool_t isRandomGenerator);
     void  SetPrimaryType(Type primaryType);
     void  SetNofPrimaries(Int_t nofPrimaries);
+    void  SetStack(TVirtualMCStack* stack);
 
     // get methods
     Bool_t GetUserDecay() const;
@@ -97,6 +98,11 @@ inline void  Ex03PrimaryGenerator::SetPrimaryType(
 inline void  Ex03PrimaryGenerator::SetNofPrimaries(Int_t nofPrimaries)
 { fNofPrimaries = nofPrimaries; }
 
+/// Set the VMC stack where the primary particles are pushed
+/// \param stack  The VMC stack
+inline void  Ex03PrimaryGenerator::SetStack(TVirtualMCStack* stack)
+{ fStack = stack; }
+
 /// Return true if particle with user decay is activated
 inline Bool_t Ex03PrimaryGenerator::GetUserDecay() const
 { return fPrimaryType == Ex03PrimaryGenerator::kUserDecay; }
@@ -17,7 +17,9 @@
 #pragma link off all functions;
  
 #pragma link C++ class  Ex03MCApplication+;
+#pragma link C++ class  TVirtualMCStackWithKeepFlag;
 #pragma link C++ class  Ex03MCStack+;
+#pragma link C++ class  Ex03MCCompactStack+;
 #pragma link C++ class  Ex03DetectorConstruction+;
 #pragma link C++ class  Ex03DetectorConstructionOld+;
 #pragma link C++ class  Ex03CalorHit+;
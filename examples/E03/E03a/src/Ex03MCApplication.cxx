@@ -17,6 +17,7 @@
 
 #include "Ex03MCApplication.h"
 #include "Ex03MCStack.h"
+#include "Ex03MCCompactStack.h"
 #include "Ex03PrimaryGenerator.h"
 #include "Ex03DetectorConstructionOld.h"
 
@@ -49,13 +50,15 @@ Ex03MCApplication::Ex03MCApplication(const char *name, const char *title)
     fEventNo(0),
     fVerbose(0),
     fStack(0),
+    fCompactStack(0),
     fDetConstruction(0),
     fCalorimeterSD(0),
     fPrimaryGenerator(0),
     fMagField(0),
     fOldGeometry(kFALSE),
     fIsControls(kFALSE),
-    fIsMaster(kTRUE)
+    fIsMaster(kTRUE),
+    fCheckStack(kFALSE)
 {
 /// Standard constructor
 /// \param name   The MC application name 
@@ -89,18 +92,21 @@ Ex03MCApplication::Ex03MCApplication(const Ex03MCApplication& origin)
     fEventNo(0),
     fVerbose(origin.fVerbose),
     fStack(0),
+    fCompactStack(0),
     fDetConstruction(origin.fDetConstruction),
     fCalorimeterSD(0),
     fPrimaryGenerator(0),
     fMagField(0),
     fOldGeometry(origin.fOldGeometry),
-    fIsMaster(kFALSE)
+    fIsMaster(kFALSE),
+    fCheckStack(origin.fCheckStack)
 {
 /// Copy constructor for cloning application on workers (in multithreading mode)
 /// \param origin   The source MC application
 
   // Create new user stack
   fStack = new Ex03MCStack(1000);
+  if ( origin.fCompactStack ) fCompactStack = new Ex03MCCompactStack(1000);
 
   // Create a calorimeter SD
   fCalorimeterSD
@@ -108,7 +114,7 @@ Ex03MCApplication::Ex03MCApplication(const Ex03MCApplication& origin)
 
   // Create a primary generator
   fPrimaryGenerator
-    = new Ex03PrimaryGenerator(*(origin.fPrimaryGenerator), fStack);
+    = new Ex03PrimaryGenerator(*(origin.fPrimaryGenerator), GetMCStack());
 
   // Constant magnetic field (in kiloGauss)
   fMagField = new TGeoUniformMagField(origin.fMagField->GetFieldValue()[0],
@@ -123,13 +129,15 @@ Ex03MCApplication::Ex03MCApplication()
     fPrintModulo(1),
     fEventNo(0),
     fStack(0),
+    fCompactStack(0),
     fDetConstruction(0),
     fCalorimeterSD(0),
     fPrimaryGenerator(0),
     fMagField(0),
     fOldGeometry(kFALSE),
     fIsControls(kFALSE),
-    fIsMaster(kTRUE)
+    fIsMaster(kTRUE),
+    fCheckStack(kFALSE)
 {    
 /// Default constructor
 }
@@ -143,6 +151,7 @@ Ex03MCApplication::~Ex03MCApplication()
 
   delete fRootManager;
   delete fStack;
+  delete fCompactStack;
   if ( fIsMaster) delete fDetConstruction;
   delete fCalorimeterSD;
   delete fPrimaryGenerator;
@@ -167,6 +176,16 @@ void Ex03MCApplication::RegisterStack() const
   }
 }
 
+//_____________________________________________________________________________
+TParticle* Ex03MCApplication::GetParticle(Int_t id) const
+{
+/// \return   The \em id -th particle in the VMC stack used in the MC
+/// \param id The index of the particle to be returned
+
+  if ( fCompactStack ) return fCompactStack->GetParticle(id);
+  return fStack->GetParticle(id);
+}
+
 //
 // public methods
 //
@@ -204,7 +223,7 @@ void Ex03MCApplication::InitMC(const char* setup)
   //fRootManager->SetDebug(true);
 #endif
   
-  gMC->SetStack(fStack);
+  gMC->SetStack(GetMCStack());
   gMC->SetMagField(fMagField);
   gMC->Init();
   gMC->BuildPhysics(); 
@@ -254,7 +273,7 @@ void Ex03MCApplication::InitForWorker() const
   //fRootManager->SetDebug(true);
 
   // Set data to MC
-  gMC->SetStack(fStack);
+  gMC->SetStack(GetMCStack());
   gMC->SetMagField(fMagField);
 
   RegisterStack();
@@ -430,7 +449,7 @@ void Ex03MCApplication::BeginPrimary()
 
   if ( fPrimaryGenerator->GetUserDecay() ) {  
     cout << "   Primary track ID = " 
-         << fStack->GetCurrentTrackNumber() << endl;
+         << GetMCStack()->GetCurrentTrackNumber() << endl;
   }   
 }
 
@@ -446,18 +465,18 @@ void Ex03MCApplication::PreTrack()
   
   // print info about K0Short decay products
   if ( fPrimaryGenerator->GetUserDecay() ) {  
-    Int_t parentID = fStack->GetCurrentParentTrackNumber();
+    Int_t parentID = GetMCStack()->GetCurrentParentTrackNumber();
 
     if ( parentID >= 0 &&
-         fStack->GetParticle(parentID)->GetPdgCode() == kK0Short  &&
-         fStack->GetCurrentTrack()->GetUniqueID() == kPDecay ) {  
+         GetParticle(parentID)->GetPdgCode() == kK0Short  &&
+         GetMCStack()->GetCurrentTrack()->GetUniqueID() == kPDecay ) {  
          // The production process is saved as TParticle unique ID
          // via Ex03MCStack
 
       cout << "      Current track " 
-           << fStack->GetCurrentTrack()->GetName()
+           << GetMCStack()->GetCurrentTrack()->GetName()
            << "  is a decay product of Parent ID = "
-           << fStack->GetCurrentParentTrackNumber() << endl;
+           << GetMCStack()->GetCurrentParentTrackNumber() << endl;
     }           
   }          
 }
@@ -537,6 +556,46 @@ void Ex03MCApplication::FinishEvent()
 
   fCalorimeterSD->EndOfEvent();
 
-  fStack->Reset();
+  if ( fCompactStack ) {
+    if ( fCheckStack && ! fCompactStack->CheckMotherIndices() ) {
+      Fatal("FinishEvent", "Inconsistent mother indices in the stack");
+    }  
+    fCompactStack->Reset();
+  }
+  else {
+    if ( fCheckStack && ! fStack->CheckMotherIndices() ) {
+      Fatal("FinishEvent", "Inconsistent mother indices in the stack");
+    }  
+    fStack->Reset();
+  }
 } 
 
+//_____________________________________________________________________________
+void Ex03MCApplication::SetCompactStack(Bool_t compactStack)
+{
+/// Switch on/off the usage of the stack with particles kept in columns
+/// (Ex03MCCompactStack) instead of Ex03MCStack.
+/// It has to be called before InitMC(). 
+/// Note that the compact stack is not written in the output file.
+/// \param compactStack  If true, the compact stack is used
+
+  if ( compactStack && ! fCompactStack ) {
+    fCompactStack = new Ex03MCCompactStack(1000);
+  }  
+  else if ( ! compactStack && fCompactStack ) {
+    delete fCompactStack;
+    fCompactStack = 0;
+  }  
+
+  fPrimaryGenerator->SetStack(GetMCStack());
+}
+
+//_____________________________________________________________________________
+TVirtualMCStack* Ex03MCApplication::GetMCStack() const
+{
+/// \return The VMC stack used in the MC
+
+  if ( fCompactStack ) return fCompactStack;
+  
+  return fStack;
+}
@@ -0,0 +1,411 @@
+//------------------------------------------------
+// The Virtual Monte Carlo examples
+// Copyright (C) 2014 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file E03/src/Ex03MCCompactStack.cxx 
+/// \brief Implementation of the Ex03MCCompactStack class 
+///
+/// Geant4 ExampleN03 adapted to Virtual Monte Carlo
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <TParticle.h>
+#include <TError.h>
+#include <Riostream.h>
+
+#include "Ex03MCCompactStack.h"
+
+using namespace std;
+
+/// \cond CLASSIMP
+ClassImp(Ex03MCCompactStack)
+/// \endcond
+
+//_____________________________________________________________________________
+Ex03MCCompactStack::Ex03MCCompactStack(Int_t size)
+  : fNtrack(0),
+    fPdg(),
+    fMother(),
+    fStatus(),
+    fProcess(),
+    fMomentum(),
+    fVertex(),
+    fPolarization(),
+    fWeight(),
+    fPending(),
+    fCurrentTrack(-1),
+    fNPrimary(0),
+    fKeepCurrentTrack(kFALSE),
+    fNextView(0)
+{
+/// Standard constructor
+/// \param size  The initial capacity of the stack
+
+  fPdg.reserve(size);
+  fMother.reserve(size);
+  fStatus.reserve(size);
+  fProcess.reserve(size);
+  fMomentum.reserve(4*size);
+  fVertex.reserve(4*size);
+  fPolarization.reserve(3*size);
+  fWeight.reserve(size);
+  fPending.reserve(size);
+
+  for (Int_t i=0; i<kNofViews; i++) fViews[i] = new TParticle();
+}
+
+//_____________________________________________________________________________
+Ex03MCCompactStack::Ex03MCCompactStack()
+  : fNtrack(0),
+    fPdg(),
+    fMother(),
+    fStatus(),
+    fProcess(),
+    fMomentum(),
+    fVertex(),
+    fPolarization(),
+    fWeight(),
+    fPending(),
+    fCurrentTrack(-1),
+    fNPrimary(0),
+    fKeepCurrentTrack(kFALSE),
+    fNextView(0)
+{
+/// Default constructor
+
+  for (Int_t i=0; i<kNofViews; i++) fViews[i] = 0;
+}
+
+//_____________________________________________________________________________
+Ex03MCCompactStack::~Ex03MCCompactStack() 
+{
+/// Destructor
+
+  for (Int_t i=0; i<kNofViews; i++) delete fViews[i];
+}
+
+// private methods
+
+//_____________________________________________________________________________
+void  Ex03MCCompactStack::SetTrack(Int_t trackId, Int_t parent, Int_t pdg,
+  	                 Double_t px, Double_t py, Double_t pz, Double_t e,
+  		         Double_t vx, Double_t vy, Double_t vz, Double_t tof,
+		         Double_t polx, Double_t poly, Double_t polz,
+		         TMCProcess mech, Double_t weight, Int_t is) 
+{
+/// Fill the particle properties in the columns at the given index;
+/// the columns are extended if the index is beyond their size.
+/// The parameters have the same meaning as in PushTrack().
+
+  if ( trackId >= Int_t(fPdg.size()) ) {
+    fPdg.resize(trackId+1);
+    fMother.resize(trackId+1);
+    fStatus.resize(trackId+1);
+    fProcess.resize(trackId+1);
+    fMomentum.resize(4*(trackId+1));
+    fVertex.resize(4*(trackId+1));
+    fPolarization.resize(3*(trackId+1));
+    fWeight.resize(trackId+1);
+  }  
+
+  fPdg[trackId] = pdg;
+  fMother[trackId] = parent;
+  fStatus[trackId] = is;
+  fProcess[trackId] = mech;
+
+  Double_t* momentum = &fMomentum[4*trackId];
+  momentum[0] = px;
+  momentum[1] = py;
+  momentum[2] = pz;
+  momentum[3] = e;
+
+  Double_t* vertex = &fVertex[4*trackId];
+  vertex[0] = vx;
+  vertex[1] = vy;
+  vertex[2] = vz;
+  vertex[3] = tof;
+
+  Float_t* polarization = &fPolarization[3*trackId];
+  polarization[0] = polx;
+  polarization[1] = poly;
+  polarization[2] = polz;
+
+  fWeight[trackId] = weight;
+}			 
+
+// public methods
+
+//_____________________________________________________________________________
+void  Ex03MCCompactStack::PushTrack(Int_t toBeDone, Int_t parent, Int_t pdg,
+  	                 Double_t px, Double_t py, Double_t pz, Double_t e,
+  		         Double_t vx, Double_t vy, Double_t vz, Double_t tof,
+		         Double_t polx, Double_t poly, Double_t polz,
+		         TMCProcess mech, Int_t& ntr, Double_t weight,
+		         Int_t is) 
+{
+/// Add a new particle in the columns and if not done, add its track 
+/// number to the pending tracks (fPending).
+/// The parameters have the same meaning as in Ex03MCStack::PushTrack().
+
+  Int_t trackId = fNtrack++;
+  SetTrack(trackId, parent, pdg, px, py, pz, e, vx, vy, vz, tof,
+           polx, poly, polz, mech, weight, is);
+
+  if (parent<0) fNPrimary++;  
+    
+  if (toBeDone) fPending.push_back(trackId);  
+  
+  ntr = trackId;   
+}			 
+
+//_____________________________________________________________________________
+void  Ex03MCCompactStack::OverwriteLastTrack(Int_t toBeDone, Int_t parent, 
+                         Int_t pdg,
+  	                 Double_t px, Double_t py, Double_t pz, Double_t e,
+  		         Double_t vx, Double_t vy, Double_t vz, Double_t tof,
+		         Double_t polx, Double_t poly, Double_t polz,
+		         TMCProcess mech, Int_t& ntr, Double_t weight,
+		         Int_t is) 
+{
+/// Replace the last particle in the columns with a new particle and 
+/// add its track number to the pending tracks if not done.
+/// The parameters have the same meaning as in PushTrack().
+
+  if ( ! fNtrack || parent < 0 ) {
+    // nothing to overwrite or a primary particle
+    PushTrack(toBeDone, parent, pdg, px, py, pz, e, vx, vy, vz, tof,
+              polx, poly, polz, mech, ntr, weight, is);
+    return;
+  }          
+
+  Int_t trackId = fNtrack - 1;
+  SetTrack(trackId, parent, pdg, px, py, pz, e, vx, vy, vz, tof,
+           polx, poly, polz, mech, weight, is);
+
+  if (toBeDone) fPending.push_back(trackId);  
+  
+  ntr = trackId;   
+}			 
+
+//_____________________________________________________________________________
+TParticle* Ex03MCCompactStack::PopNextTrack(Int_t& itrack)
+{
+/// Get next particle for tracking from the stack.
+/// \return       The popped particle object
+/// \param track  The index of the popped track
+
+  itrack = -1;
+  if  (fPending.empty()) return 0;
+		      
+  fCurrentTrack = fPending.back();
+  fPending.pop_back();
+  itrack = fCurrentTrack;
+  
+  return GetParticle(fCurrentTrack);
+}    
+
+//_____________________________________________________________________________
+TParticle* Ex03MCCompactStack::PopPrimaryForTracking(Int_t i)
+{
+/// Return \em i -th particle.
+/// \return   The popped primary particle object
+/// \param i  The index of primary particle to be popped
+
+  if (i < 0 || i >= fNPrimary)
+    Fatal("GetPrimaryForTracking", "Index out of range"); 
+  
+  return GetParticle(i);
+}     
+
+//_____________________________________________________________________________
+void Ex03MCCompactStack::Print(Option_t* /*option*/) const 
+{
+/// Print info for all particles.
+
+  cout << "Ex03MCCompactStack Info  " << endl;
+  cout << "Total number of particles:   " <<  GetNtrack() << endl;
+  cout << "Number of primary particles: " <<  GetNprimary() << endl;
+  cout << "Memory of columns (bytes):   " <<  GetNofBytes() << endl;
+
+  for (Int_t i=0; i<GetNtrack(); i++)
+    GetParticle(i)->Print();
+}
+
+//_____________________________________________________________________________
+void Ex03MCCompactStack::Reset()
+{
+/// Reset the number of particles and the pending tracks;
+/// the allocated columns are kept for the next event.
+
+  fNtrack = 0;
+  fCurrentTrack = -1;
+  fNPrimary = 0;
+  fKeepCurrentTrack = kFALSE;
+  fPending.clear();
+}       
+
+//_____________________________________________________________________________
+Bool_t Ex03MCCompactStack::CheckMotherIndices() const
+{
+/// Check the consistency of the mother indices of all particles
+/// (see Ex03MCStack::CheckMotherIndices()).
+/// \return  kTRUE if all mother indices are valid
+
+  Bool_t isValid = kTRUE;
+  for (Int_t i=0; i<GetNtrack(); i++) {
+    Int_t mother = fMother[i];
+
+    if ( i < fNPrimary ) {
+      if ( mother != -1 ) {
+        Warning("CheckMotherIndices", 
+                "Primary particle %d has mother %d", i, mother);
+        isValid = kFALSE;
+      }
+      continue;
+    }  
+
+    if ( mother < 0 || mother >= i ) {
+      Warning("CheckMotherIndices", 
+              "Particle %d: mother index %d out of range", i, mother);
+      isValid = kFALSE;
+      continue;
+    }
+      
+    if ( GetTime(i) < GetTime(mother) ) {
+      Warning("CheckMotherIndices", 
+              "Particle %d: created before its mother %d", i, mother);
+      isValid = kFALSE;
+    }      
+  }
+  
+  return isValid;
+}       
+
+//_____________________________________________________________________________
+void  Ex03MCCompactStack::SetCurrentTrack(Int_t track) 
+{
+/// Set the current track number to a given value.
+/// \param  track The current track number
+
+  if ( track != fCurrentTrack ) fKeepCurrentTrack = kFALSE;
+  fCurrentTrack = track;
+}     
+
+//_____________________________________________________________________________
+void  Ex03MCCompactStack::SetKeepCurrentTrack(Bool_t keep) 
+{
+/// Flag the current track to be kept (so that it is not overwritten).
+/// \param  keep The keep flag value
+
+  fKeepCurrentTrack = keep;
+}     
+
+//_____________________________________________________________________________
+Int_t  Ex03MCCompactStack::GetNtrack() const 
+{
+/// \return  The total number of all tracks.
+
+  return fNtrack;
+}  
+
+//_____________________________________________________________________________
+Int_t  Ex03MCCompactStack::GetNprimary() const 
+{
+/// \return  The total number of primary tracks.
+
+  return fNPrimary;
+}  
+
+//_____________________________________________________________________________
+TParticle*  Ex03MCCompactStack::GetCurrentTrack() const 
+{
+/// \return  The current track particle
+
+  if ( fCurrentTrack < 0 || fCurrentTrack >= fNtrack ) {
+    Warning("GetCurrentTrack", "Current track not found in the stack");
+    return 0;
+  }  
+
+  return GetParticle(fCurrentTrack);
+}  
+
+//_____________________________________________________________________________
+Int_t  Ex03MCCompactStack::GetCurrentTrackNumber() const 
+{
+/// \return  The current track number
+
+  return fCurrentTrack;
+}  
+
+//_____________________________________________________________________________
+Int_t  Ex03MCCompactStack::GetCurrentParentTrackNumber() const 
+{
+/// \return  The current track parent ID.
+
+  if ( fCurrentTrack < 0 || fCurrentTrack >= fNtrack ) return -1;
+
+  return fMother[fCurrentTrack];
+}  
+
+//_____________________________________________________________________________
+TParticle*  Ex03MCCompactStack::GetParticle(Int_t id) const
+{
+/// Fill the next TParticle view with the \em id -th particle properties.
+/// As in Ex03MCStack, the track ID is set as the second mother and 
+/// the creator process as the unique ID.
+/// \return   The TParticle view of the \em id -th particle
+/// \param id The index of the particle to be returned
+
+  if (id < 0 || id >= fNtrack)
+    Fatal("GetParticle", "Index out of range"); 
+
+  const Double_t* momentum = &fMomentum[4*id];
+  const Double_t* vertex = &fVertex[4*id];
+  const Float_t* polarization = &fPolarization[3*id];
+
+  TParticle* particle = fViews[fNextView];
+  fNextView = (fNextView + 1) % kNofViews;
+
+  particle->SetPdgCode(fPdg[id]);
+  particle->SetStatusCode(fStatus[id]);
+  particle->SetFirstMother(fMother[id]);
+  particle->SetLastMother(id);
+  particle->SetFirstDaughter(-1);
+  particle->SetLastDaughter(-1);
+  particle->SetMomentum(momentum[0], momentum[1], momentum[2], momentum[3]);
+  particle->SetProductionVertex(vertex[0], vertex[1], vertex[2], vertex[3]);
+  particle->SetPolarisation(polarization[0], polarization[1], polarization[2]);
+  particle->SetWeight(fWeight[id]);
+  particle->SetUniqueID(fProcess[id]);
+   
+  return particle;
+}
+
+//_____________________________________________________________________________
+Bool_t  Ex03MCCompactStack::GetKeepCurrentTrack() const 
+{
+/// \return  The keep flag of the current track
+
+  return fKeepCurrentTrack;
+}  
+
+//_____________________________________________________________________________
+ULong_t  Ex03MCCompactStack::GetNofBytes() const 
+{
+/// \return  The memory allocated by the columns (in bytes)
+
+  return fPdg.capacity()*sizeof(Int_t) 
+       + fMother.capacity()*sizeof(Int_t) 
+       + fStatus.capacity()*sizeof(Int_t) 
+       + fProcess.capacity()*sizeof(Int_t) 
+       + fMomentum.capacity()*sizeof(Double_t) 
+       + fVertex.capacity()*sizeof(Double_t) 
+       + fPolarization.capacity()*sizeof(Float_t) 
+       + fWeight.capacity()*sizeof(Double_t) 
+       + fPending.capacity()*sizeof(Int_t); 
+}  
@@ -32,7 +32,10 @@ ClassImp(Ex03MCStack)
 Ex03MCStack::Ex03MCStack(Int_t size)
   : fParticles(0),
     fCurrentTrack(-1),
-    fNPrimary(0)
+    fNPrimary(0),
+    fKeepCurrentTrack(kFALSE),
+    fNofPushedTracks(0),
+    fNofOverwrittenTracks(0)
 {
 /// Standard constructor
 /// \param size  The stack size
@@ -44,7 +47,10 @@ Ex03MCStack::Ex03MCStack(Int_t size)
 Ex03MCStack::Ex03MCStack()
   : fParticles(0),
     fCurrentTrack(-1),
-    fNPrimary(0)
+    fNPrimary(0),
+    fKeepCurrentTrack(kFALSE),
+    fNofPushedTracks(0),
+    fNofOverwrittenTracks(0)
 {
 /// Default constructor
 }
@@ -112,6 +118,50 @@ void  Ex03MCStack::PushTrack(Int_t toBeDone, Int_t parent, Int_t pdg,
   if (toBeDone) fStack.push(particle);  
   
   ntr = GetNtrack() - 1;   
+  ++fNofPushedTracks;
+}			 
+
+//_____________________________________________________________________________
+void  Ex03MCStack::OverwriteLastTrack(Int_t toBeDone, Int_t parent, Int_t pdg,
+  	                 Double_t px, Double_t py, Double_t pz, Double_t e,
+  		         Double_t vx, Double_t vy, Double_t vz, Double_t tof,
+		         Double_t polx, Double_t poly, Double_t polz,
+		         TMCProcess mech, Int_t& ntr, Double_t weight,
+		         Int_t is) 
+{
+/// Replace the last particle in the particles array (fParticles) with 
+/// a new particle and push it into stack (fStack) if not done.
+/// The MC calls this function only if the last particle was already tracked
+/// (and so it is not in fStack), it has no daughters and it was not flagged
+/// to be kept (see TVirtualMCStackWithKeepFlag).
+/// The parameters have the same meaning as in PushTrack().
+
+  if ( ! GetNtrack() || parent < 0 ) {
+    // nothing to overwrite or a primary particle
+    PushTrack(toBeDone, parent, pdg, px, py, pz, e, vx, vy, vz, tof,
+              polx, poly, polz, mech, ntr, weight, is);
+    return;
+  }          
+
+  const Int_t kFirstDaughter=-1;
+  const Int_t kLastDaughter=-1;
+  
+  TClonesArray& particlesRef = *fParticles;
+  Int_t trackId = GetNtrack() - 1;
+  fParticles->RemoveAt(trackId);
+  TParticle* particle
+    = new(particlesRef[trackId]) 
+      TParticle(pdg, is, parent, trackId, kFirstDaughter, kLastDaughter,
+		px, py, pz, e, vx, vy, vz, tof);
+   
+  particle->SetPolarisation(polx, poly, polz);
+  particle->SetWeight(weight);
+  particle->SetUniqueID(mech);
+
+  if (toBeDone) fStack.push(particle);  
+  
+  ntr = trackId;   
+  ++fNofOverwrittenTracks;
 }			 
 
 //_____________________________________________________________________________
@@ -168,18 +218,75 @@ void Ex03MCStack::Reset()
 
   fCurrentTrack = -1;
   fNPrimary = 0;
+  fKeepCurrentTrack = kFALSE;
   fParticles->Clear();
 }       
 
+//_____________________________________________________________________________
+Bool_t Ex03MCStack::CheckMotherIndices() const
+{
+/// Check the consistency of the mother indices of all particles:
+/// the primary particles must have no mother and the secondary particles 
+/// must refer to a mother which precedes them in the array and which was 
+/// created before them.
+/// \return  kTRUE if all mother indices are valid
+
+  Bool_t isValid = kTRUE;
+  for (Int_t i=0; i<GetNtrack(); i++) {
+    TParticle* particle = GetParticle(i);
+    Int_t mother = particle->GetFirstMother();
+
+    if ( particle->GetSecondMother() != i ) {
+      Warning("CheckMotherIndices", 
+              "Particle %d: wrong track ID %d", i, particle->GetSecondMother());
+      isValid = kFALSE;
+    }        
+
+    if ( i < fNPrimary ) {
+      if ( mother != -1 ) {
+        Warning("CheckMotherIndices", 
+                "Primary particle %d has mother %d", i, mother);
+        isValid = kFALSE;
+      }
+      continue;
+    }  
+
+    if ( mother < 0 || mother >= i ) {
+      Warning("CheckMotherIndices", 
+              "Particle %d: mother index %d out of range", i, mother);
+      isValid = kFALSE;
+      continue;
+    }
+      
+    if ( particle->T() < GetParticle(mother)->T() ) {
+      Warning("CheckMotherIndices", 
+              "Particle %d: created before its mother %d", i, mother);
+      isValid = kFALSE;
+    }      
+  }
+  
+  return isValid;
+}       
+
 //_____________________________________________________________________________
 void  Ex03MCStack::SetCurrentTrack(Int_t track) 
 {
 /// Set the current track number to a given value.
 /// \param  track The current track number
 
+  if ( track != fCurrentTrack ) fKeepCurrentTrack = kFALSE;
   fCurrentTrack = track;
 }     
 
+//_____________________________________________________________________________
+void  Ex03MCStack::SetKeepCurrentTrack(Bool_t keep) 
+{
+/// Flag the current track to be kept (so that it is not overwritten).
+/// \param  keep The keep flag value
+
+  fKeepCurrentTrack = keep;
+}     
+
 //_____________________________________________________________________________
 Int_t  Ex03MCStack::GetNtrack() const 
 {
@@ -242,4 +349,30 @@ TParticle*  Ex03MCStack::GetParticle(Int_t id) const
   return (TParticle*)fParticles->At(id);
 }
 
+//_____________________________________________________________________________
+Bool_t  Ex03MCStack::GetKeepCurrentTrack() const 
+{
+/// \return  The keep flag of the current track
+
+  return fKeepCurrentTrack;
+}  
+
+//_____________________________________________________________________________
+Int_t  Ex03MCStack::GetNofPushedTracks() const 
+{
+/// \return  The number of tracks pushed via PushTrack() since the stack 
+///          creation
+
+  return fNofPushedTracks;
+}  
+
+//_____________________________________________________________________________
+Int_t  Ex03MCStack::GetNofOverwrittenTracks() const 
+{
+/// \return  The number of tracks overwritten via OverwriteLastTrack()
+///          since the stack creation
+
+  return fNofOverwrittenTracks;
+}  
+
 
@@ -247,6 +247,23 @@ do
         $RUNG4_OPT "test_E03_6.C(\"g4Config5.C\", kFALSE)" >& tmpfile
         if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
         cat tmpfile >> $OUT/test_g4_tgeo_nat.out
+        $RUNG4_OPT "test_E03_9.C(\"g4Config.C\", kFALSE)" >& tmpfile
+        if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
+        cat tmpfile >> $OUT/test_g4_tgeo_nat.out
+        $RUNG4_OPT "test_E03_11.C(\"g4Config6.C\", kFALSE)" >& tmpfile
+        if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
+        cat tmpfile >> $OUT/test_g4_tgeo_nat.out
+        if [ "$OPTION" = "E03a" ]; then
+          $RUNG4_OPT "test_E03_7.C(\"g4Config.C\", kFALSE)" >& tmpfile
+          if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
+          cat tmpfile >> $OUT/test_g4_tgeo_nat.out
+          $RUNG4_OPT "test_E03_8.C(\"g4Config.C\", kFALSE)" >& tmpfile
+          if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
+          cat tmpfile >> $OUT/test_g4_tgeo_nat.out
+          $RUNG4_OPT "test_E03_10.C(\"g4Config.C\", kFALSE)" >& tmpfile
+          if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
+          cat tmpfile >> $OUT/test_g4_tgeo_nat.out
+        fi
         if [ "$TMP_FAILED" -ne "0" ]; then FAILED=`expr $FAILED + 1`; else PASSED=`expr $PASSED + 1`; fi
 
         echo "... Running test with G4, geometry via TGeo, TGeo navigation"
@@ -298,6 +315,10 @@ do
         $RUNG4_OPT "test_E03_4.C(\"g4tgeoConfigOld.C\", kTRUE)" >& tmpfile
         if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
         cat tmpfile >> $OUT/test_g4_vmc_tgeo.out
+        $RUNG4_OPT "test_E03_1.C(\"g4tgeoConfig6.C\", kTRUE)" >& tmpfile
+        if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
+        if grep -q "G4Root_W001" tmpfile; then TMP_FAILED="1" ; fi
+        cat tmpfile >> $OUT/test_g4_vmc_tgeo.out
         if [ "$TMP_FAILED" -ne "0" ]; then FAILED=`expr $FAILED + 1`; else PASSED=`expr $PASSED + 1`; fi
 
         echo "... Running test with G4, geometry via G4,   Native navigation"
@@ -36,6 +36,7 @@
 #endif
 
 #include <map>
+#include <vector>
 
 class TObjArray;
 class TGeoManager;
@@ -62,6 +63,13 @@ class TVirtualUserPostDetConstruction;
 ///  - TGeoShape           ---> TG4RootSolid  : public G4Solid           
 ///  - TGeoNode            ---> G4PVPlacement : public G4VPhysicalVolume 
 ///                                                                      
+/// The cross-references TGeoNode <-> G4VPhysicalVolume, which are queried
+/// by the navigator at every locate, are kept in flat arrays: the nodes are
+/// given a dense ID stored as their TObject unique ID, the physical volumes
+/// are indexed by their G4 instance ID. The index of each node in its
+/// mother volume is kept as well, so that the navigator can step down
+/// the TGeo hierarchy without searching the daughters list.
+///                                                                      
 /// \author A. Gheata; CERN
 
 class TG4RootDetectorConstruction : public G4VUserDetectorConstruction {
@@ -99,13 +107,14 @@ private:
    typedef G4PVolumeMap_t::value_type                 G4PVolumeVal_t;
    G4PVolumeMap_t        fG4PVolumeMap; //!< map of G4 physical volumes
 
-   /// the map from G4VPhysicalVolume to TGeoNode
-   typedef std::map<const G4VPhysicalVolume *, TGeoNode *> PVolumeMap_t;
-   /// the constant iterator for the map from G4VPhysicalVolume to TGeoNode
-   typedef PVolumeMap_t::const_iterator               PVolumeIt_t;
-   /// the value type for the map from G4VPhysicalVolume to TGeoNode
-   typedef PVolumeMap_t::value_type                   PVolumeVal_t;
-   PVolumeMap_t          fPVolumeMap; //!< map of TGeo volumes
+   /// the vector of G4VPhysicalVolume indexed by the TGeoNode unique ID
+   typedef std::vector<G4VPhysicalVolume *>                G4PVolumeVector_t;
+   G4PVolumeVector_t     fG4PVolumes; //!< G4 physical volumes indexed by node ID
+   /// the vector of TGeoNode indexed by the node ID or by the G4VPhysicalVolume instance ID
+   typedef std::vector<TGeoNode *>                         NodeVector_t;
+   NodeVector_t          fNodes;       //!< TGeo nodes indexed by node ID
+   NodeVector_t          fPVolumeNodes; //!< TGeo nodes indexed by G4 physical volume instance ID
+   std::vector<Int_t>    fDaughterIndices; //!< node indices in their mother volumes indexed by node ID
 
 protected:
    Bool_t                fIsConstructed;   ///< flag Construct() called
@@ -120,7 +129,7 @@ protected:
    // Converters TGeo->G4 for basic types
    G4VSolid             *CreateG4Solid(TGeoShape *shape);
    G4LogicalVolume      *CreateG4LogicalVolume(TGeoVolume *vol);
-   G4VPhysicalVolume    *CreateG4PhysicalVolume(TGeoNode *node);
+   G4VPhysicalVolume    *CreateG4PhysicalVolume(TGeoNode *node, Int_t daughterIndex=-1);
    G4Material           *CreateG4Material(const TGeoMaterial *mat);
    G4RotationMatrix     *CreateG4Rotation(const TGeoMatrix *matrix);
 
@@ -142,6 +151,7 @@ public:
    TGeoVolume           *GetVolume(const G4LogicalVolume *g4vol) const;
    G4VPhysicalVolume    *GetG4VPhysicalVolume(const TGeoNode *node) const;
    TGeoNode             *GetNode(const G4VPhysicalVolume *g4vol) const;
+   Int_t                 GetDaughterIndex(const TGeoNode *node) const;
                          /// Return the sensitive detector hook
    TVirtualUserPostDetConstruction        *GetSDInit() const {return fSDInit;}
                          /// Return the flag Construct() called
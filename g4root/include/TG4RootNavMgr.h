@@ -23,6 +23,8 @@
 
 #include "G4Threading.hh"
 
+#include "TG4RootNavStatistics.h"
+
 class TGeoManager;
 class TG4RootNavigator;
 class TG4RootDetectorConstruction;
@@ -47,6 +49,8 @@ protected:
 private:
    static G4ThreadLocal TG4RootNavMgr *fRootNavMgr; ///< Static pointer to singleton
    static TG4RootNavMgr *fgMasterInstance; 
+   static TG4RootNavStatistics fgMergedStatistics; ///< Navigation counters merged over threads
+   static Int_t          fgNofMergedThreads;  ///< Number of threads (workers in MT) merged in fgMergedStatistics
 
 public:
    static TG4RootNavMgr *GetInstance(TGeoManager *geom=0);
@@ -62,6 +66,11 @@ public:
    void                  PrintG4State() const;
    void                  SetVerboseLevel(Int_t level);
 
+   // Navigation statistics
+   void                  MergeStatistics();
+   static void           CheckMergedStatistics();
+   static void           ClearMergedStatistics();
+
    void                  SetNavigator(TG4RootNavigator *nav);
                          /// Return the G4 navigator working with TGeo
    TG4RootNavigator     *GetNavigator() const {return fNavigator;}
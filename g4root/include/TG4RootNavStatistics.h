@@ -0,0 +1,47 @@
+// @(#)root/g4root:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/// \file TG4RootNavStatistics.h
+/// \brief Definition of the TG4RootNavStatistics class 
+///
+
+#ifndef ROOT_TG4RootNavStatistics
+#define ROOT_TG4RootNavStatistics
+
+#include <Rtypes.h>
+
+/// \brief Navigation counters of TG4RootNavigator.
+///
+/// Each navigator (one per thread) keeps its own counters; they are 
+/// merged across threads by TG4RootNavMgr at the end of run.
+
+class TG4RootNavStatistics {
+
+public:
+   Long64_t              fNofLocates;          ///< LocateGlobalPointAndSetup calls
+   Long64_t              fNofRelativeLocates;  ///< Locates searching from the current state
+   Long64_t              fNofFullLocates;      ///< Locates with history reset or non-relative search
+   Long64_t              fNofBoundaryCrossings;///< Locates on a boundary (entering/exiting)
+   Long64_t              fNofSteps;            ///< ComputeStep calls
+   Long64_t              fNofZeroSteps;        ///< Zero steps returned by ComputeStep
+   Long64_t              fNofAbandonedSteps;   ///< Fake steps forced after too many zero steps
+   Long64_t              fNofSafetyHits;       ///< Safeties reused from the last computation
+   Long64_t              fNofSafetyMisses;     ///< Safeties computed by TGeo
+   Long64_t              fNofSafetyReuses;     ///< Safeties estimated from the last safety sphere
+   Long64_t              fNofSafetyCheckFailures; ///< Overestimated reused safeties (check mode)
+
+   TG4RootNavStatistics();
+   virtual ~TG4RootNavStatistics() {}
+
+   void                  Add(const TG4RootNavStatistics &other);
+   void                  Print(const char *title) const;
+   void                  Reset();
+};
+#endif
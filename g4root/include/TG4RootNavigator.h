@@ -23,6 +23,10 @@
 
 #include <Rtypes.h>
 
+#include "TG4RootNavStatistics.h"
+
+#include <vector>
+
 class TGeoManager;
 class TGeoNavigator;
 class TGeoNode;
@@ -49,9 +53,19 @@ protected:
    G4ThreeVector         fSafetyOrig;      ///< Last computed safety origin
    G4double              fLastSafety;      ///< Last computed safety
    Int_t                 fNzeroSteps;      ///< Number of zero steps in ComputeStep
+   Bool_t                fIsSynchronized;  ///< Flag that fSyncNodes describe the current history
+   std::vector<TGeoNode*> fSyncNodes;      ///< TGeo nodes of the last synchronized history levels
+   TG4RootNavStatistics  fStatistics;      ///< Navigation counters of this (thread) navigator
+
+   static Bool_t         fgSafetyReuse;    ///< Option to reuse the last safety sphere
+   static Double_t       fgSafetyReuseFraction; ///< Min. fraction of the last safety to be reused
+   static Bool_t         fgSafetyCheck;    ///< Option to validate reused safety
 private:
    G4VPhysicalVolume *SynchronizeHistory();
    TGeoNode          *SynchronizeGeoManager();
+   Bool_t             IsHistorySynchronized() const;
+   G4double           ComputeTGeoSafety(const G4ThreeVector &globalpoint);
+   void               CheckSafety(const G4ThreeVector &globalpoint, G4double safety);
       
 public:
    TG4RootNavigator();
@@ -62,6 +76,26 @@ public:
    
    /// Return the navigation history
    G4NavigationHistory *GetHistory() {return &fHistory;}
+   /// Return the navigation counters
+   const TG4RootNavStatistics &GetStatistics() const {return fStatistics;}
+   /// Reset the navigation counters
+   void              ResetStatistics() {fStatistics.Reset();}
+
+   // Safety sphere reuse options (common to all threads)
+   /// Set the option to reuse the last safety sphere in ComputeSafety
+   /// (off by default; it may change the navigation results and the number 
+   /// of steps, use SetSafetyCheck() to validate it for a given geometry)
+   static void       SetSafetyReuse(Bool_t value) {fgSafetyReuse = value;}
+   /// Set the min. fraction of the last safety which can be reused
+   static void       SetSafetyReuseFraction(Double_t value) {fgSafetyReuseFraction = value;}
+   /// Set the option to validate the reused safety against the full computation
+   static void       SetSafetyCheck(Bool_t value) {fgSafetyCheck = value;}
+   /// Return the option to reuse the last safety sphere
+   static Bool_t     GetSafetyReuse() {return fgSafetyReuse;}
+   /// Return the min. fraction of the last safety which can be reused
+   static Double_t   GetSafetyReuseFraction() {return fgSafetyReuseFraction;}
+   /// Return the option to validate the reused safety
+   static Bool_t     GetSafetyCheck() {return fgSafetyCheck;}
    
    // Virtual methods for navigation
    virtual  G4double ComputeStep(const G4ThreeVector &pGlobalPoint,
@@ -31,6 +31,9 @@ class TGeoShape;
 /// \brief GEANT4 solid implemented by a ROOT shape. 
 ///
 /// Visualization methods not implemented.     
+/// The extent and the volume are provided from the TGeo shape bounding box 
+/// and capacity, so that the G4 smart voxels can be built for volumes with
+/// TG4RootSolid daughters.
 ///
 /// \author A. Gheata; CERN
 
@@ -38,12 +41,16 @@ class TG4RootSolid : public G4VSolid {
 
 protected:
    TGeoShape            *fShape;      ///< TGeo associated shape
+   G4double              fCubicVolume;///< Cached volume (negative if not computed)
 
 public:
-   TG4RootSolid() : G4VSolid(""), fShape(0) {} ///< Default ctor
+   TG4RootSolid() : G4VSolid(""), fShape(0), fCubicVolume(-1.) {} ///< Default ctor
    TG4RootSolid(TGeoShape *shape);
    virtual ~TG4RootSolid() {}                  ///< Destructor
 
+#if G4VERSION_NUMBER >= 1030
+   virtual void   BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const;
+#endif
    virtual G4bool CalculateExtent(const EAxis pAxis,
 			   const G4VoxelLimits& pVoxelLimit,
 			   const G4AffineTransform& pTransform,
@@ -188,7 +188,7 @@ void TG4RootDetectorConstruction::CreateG4PhysicalVolumes()
       mother = next.GetNode(next.GetLevel()-1);
       if (mother && node->GetMotherVolume() != mother->GetVolume())
          node->SetMotherVolume(mother->GetVolume());
-      CreateG4PhysicalVolume(node);
+      CreateG4PhysicalVolume(node, next.GetIndex(next.GetLevel()));
    }
    
    G4cout << "===> GEANT4 physical volumes created and mapped to TGeo hierarchy..." << G4endl;
@@ -267,9 +267,11 @@ G4LogicalVolume *TG4RootDetectorConstruction::CreateG4LogicalVolume(TGeoVolume *
 }
    
 //______________________________________________________________________________
-G4VPhysicalVolume *TG4RootDetectorConstruction::CreateG4PhysicalVolume(TGeoNode *node)
+G4VPhysicalVolume *TG4RootDetectorConstruction::CreateG4PhysicalVolume(TGeoNode *node,
+                                                                   Int_t daughterIndex)
 {
-/// Create a G4VPhysicalVolume object based on a TGeo node.
+/// Create a G4VPhysicalVolume object based on a TGeo node. The index of the node
+/// in its mother volume is recorded; if not provided, it is searched for.
    if (!node) return NULL;
    node->cd();
    G4VPhysicalVolume *pPhysicalVolume = GetG4VPhysicalVolume(node);
@@ -301,7 +303,20 @@ G4VPhysicalVolume *TG4RootDetectorConstruction::CreateG4PhysicalVolume(TGeoNode
    pPhysicalVolume = new G4PVPlacement(pRot,tlate,pCurrentLogical,pName,
                                        pMotherLogical,pMany,pCopyNo);
    fG4PVolumeMap.insert(G4PVolumeVal_t(node, pPhysicalVolume));
-   fPVolumeMap.insert(PVolumeVal_t(pPhysicalVolume, node));
+   // Dense cross-references used by the navigator
+   node->SetUniqueID(fNodes.size()+1);
+   fNodes.push_back(node);
+   fG4PVolumes.push_back(pPhysicalVolume);
+   TGeoVolume *motherVolume = node->GetMotherVolume();
+   if (motherVolume &&
+       (daughterIndex < 0 || daughterIndex >= motherVolume->GetNdaughters() ||
+        motherVolume->GetNode(daughterIndex) != node)) {
+      daughterIndex = motherVolume->GetIndex(node);
+   }   
+   fDaughterIndices.push_back(daughterIndex);
+   size_t pvId = pPhysicalVolume->GetInstanceID();
+   if (pvId >= fPVolumeNodes.size()) fPVolumeNodes.resize(pvId+1, 0);
+   fPVolumeNodes[pvId] = node;
    return pPhysicalVolume;                                             
 }
 
@@ -442,6 +457,11 @@ TGeoVolume *TG4RootDetectorConstruction::GetVolume(const G4LogicalVolume *g4vol)
 G4VPhysicalVolume *TG4RootDetectorConstruction::GetG4VPhysicalVolume(const TGeoNode *node) const
 {
 /// Retreive a G4 physical volume mapped to a ROOT node.
+/// The node unique ID set at creation time is used as index in the flat array;
+/// the map is searched only if the ID was modified in the meantime.
+   if (!node) return NULL;
+   UInt_t id = node->GetUniqueID();
+   if (id && id <= fNodes.size() && fNodes[id-1] == node) return fG4PVolumes[id-1];
    G4PVolumeIt_t it = fG4PVolumeMap.find(node);
    if (it != fG4PVolumeMap.end()) return it->second;
    return NULL;
@@ -451,7 +471,20 @@ G4VPhysicalVolume *TG4RootDetectorConstruction::GetG4VPhysicalVolume(const TGeoN
 TGeoNode *TG4RootDetectorConstruction::GetNode(const G4VPhysicalVolume *g4pvol) const
 {
 /// Retreive a TGeo node mapped to a G4 physical volume.
-   PVolumeIt_t it = fPVolumeMap.find(g4pvol);
-   if (it != fPVolumeMap.end()) return it->second;
+/// The G4 physical volume instance ID is used as index in the flat array.
+   if (!g4pvol) return NULL;
+   size_t id = g4pvol->GetInstanceID();
+   if (id < fPVolumeNodes.size()) return fPVolumeNodes[id];
    return NULL;
 }   
+
+//______________________________________________________________________________
+Int_t TG4RootDetectorConstruction::GetDaughterIndex(const TGeoNode *node) const
+{
+/// Retreive the index of a ROOT node in its mother volume, as recorded when
+/// the node was converted. Return -1 if not available.
+   if (!node) return -1;
+   UInt_t id = node->GetUniqueID();
+   if (id && id <= fNodes.size() && fNodes[id-1] == node) return fDaughterIndices[id-1];
+   return -1;
+}   
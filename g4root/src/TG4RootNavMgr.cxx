@@ -22,6 +22,7 @@
 #include "G4RunManager.hh"
 #include "G4TransportationManager.hh"
 #include "G4PropagatorInField.hh"
+#include "G4AutoLock.hh"
 
 /// \cond CLASSIMP
 //ClassImp(TG4RootNavMgr)
@@ -29,6 +30,12 @@
 
 G4ThreadLocal TG4RootNavMgr *TG4RootNavMgr::fRootNavMgr = 0;
 TG4RootNavMgr *TG4RootNavMgr::fgMasterInstance = 0; 
+TG4RootNavStatistics TG4RootNavMgr::fgMergedStatistics;
+Int_t TG4RootNavMgr::fgNofMergedThreads = 0;
+
+namespace {
+  G4Mutex mergeMutex = G4MUTEX_INITIALIZER;
+}
 
 //______________________________________________________________________________
 TG4RootNavMgr::TG4RootNavMgr()
@@ -196,7 +203,57 @@ void TG4RootNavMgr::SetVerboseLevel(Int_t level)
 //______________________________________________________________________________
 void TG4RootNavMgr::PrintG4State() const
 {
-/// Print current G4 state.
+/// Print current G4 state and the navigation statistics: the counters merged
+/// over threads (the worker threads in MT mode) on master if 
+/// MergeStatistics() was called, the counters of this thread navigator 
+/// otherwise.
    G4NavigationHistory *history = fNavigator->GetHistory();
    G4cout << *history << G4endl;
+   if (!G4Threading::IsWorkerThread() && fgNofMergedThreads) {
+      TString title = TString::Format("merged over %d threads", fgNofMergedThreads);
+      fgMergedStatistics.Print(title.Data());
+   } else {
+      fNavigator->GetStatistics().Print("this thread");
+   }   
+}
+
+//______________________________________________________________________________
+void TG4RootNavMgr::MergeStatistics()
+{
+/// Add the navigation counters of this thread navigator to the merged ones
+/// and reset them. To be called at the end of run on all threads.
+/// In MT mode the master navigator, which does not track, is not merged,
+/// so the merged counters are over the worker threads only.
+   if (!fNavigator) return;
+   if (G4RunManager::GetRunManager()->GetRunManagerType() == 
+       G4RunManager::masterRM) return;
+   G4AutoLock lm(&mergeMutex);
+   fgMergedStatistics.Add(fNavigator->GetStatistics());
+   fgNofMergedThreads++;
+   lm.unlock();
+   fNavigator->ResetStatistics();
+}
+
+//______________________________________________________________________________
+void TG4RootNavMgr::CheckMergedStatistics()
+{
+/// Issue a warning if the safety check failed on any thread.
+/// To be called on master after the counters of all threads were merged,
+/// as the warnings issued on workers may be filtered from the output.
+   if (!fgMergedStatistics.fNofSafetyCheckFailures) return;
+   G4ExceptionDescription description;
+   description << "      " 
+      << fgMergedStatistics.fNofSafetyCheckFailures 
+      << " reused safeties were overestimated in this run";
+   G4Exception("TG4RootNavMgr::CheckMergedStatistics",
+               "G4Root_W001", JustWarning, description);
+}
+
+//______________________________________________________________________________
+void TG4RootNavMgr::ClearMergedStatistics()
+{
+/// Clear the navigation counters merged over threads.
+   G4AutoLock lm(&mergeMutex);
+   fgMergedStatistics.Reset();
+   fgNofMergedThreads = 0;
 }
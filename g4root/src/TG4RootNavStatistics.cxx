@@ -0,0 +1,83 @@
+// @(#)root/g4root:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/// \file TG4RootNavStatistics.cxx
+/// \brief Implementation of the TG4RootNavStatistics class 
+///
+
+#include "TG4RootNavStatistics.h"
+
+#include "globals.hh"
+
+//______________________________________________________________________________
+TG4RootNavStatistics::TG4RootNavStatistics()
+                     :fNofLocates(0),
+                      fNofRelativeLocates(0),
+                      fNofFullLocates(0),
+                      fNofBoundaryCrossings(0),
+                      fNofSteps(0),
+                      fNofZeroSteps(0),
+                      fNofAbandonedSteps(0),
+                      fNofSafetyHits(0),
+                      fNofSafetyMisses(0),
+                      fNofSafetyReuses(0),
+                      fNofSafetyCheckFailures(0)
+{
+/// Default ctor.
+}
+
+//______________________________________________________________________________
+void TG4RootNavStatistics::Add(const TG4RootNavStatistics &other)
+{
+/// Add the counters of another object.
+   fNofLocates           += other.fNofLocates;
+   fNofRelativeLocates   += other.fNofRelativeLocates;
+   fNofFullLocates       += other.fNofFullLocates;
+   fNofBoundaryCrossings += other.fNofBoundaryCrossings;
+   fNofSteps             += other.fNofSteps;
+   fNofZeroSteps         += other.fNofZeroSteps;
+   fNofAbandonedSteps    += other.fNofAbandonedSteps;
+   fNofSafetyHits        += other.fNofSafetyHits;
+   fNofSafetyMisses      += other.fNofSafetyMisses;
+   fNofSafetyReuses      += other.fNofSafetyReuses;
+   fNofSafetyCheckFailures += other.fNofSafetyCheckFailures;
+}
+
+//______________________________________________________________________________
+void TG4RootNavStatistics::Print(const char *title) const
+{
+/// Print the counters.
+   Long64_t nofSafeties = fNofSafetyHits + fNofSafetyReuses + fNofSafetyMisses;
+   G4cout << "=== G4Root navigation statistics (" << title << ") ===" << G4endl;
+   G4cout << "   locates:              " << fNofLocates << G4endl;
+   G4cout << "     relative search:    " << fNofRelativeLocates << G4endl;
+   G4cout << "     full search:        " << fNofFullLocates << G4endl;
+   G4cout << "     boundary crossing:  " << fNofBoundaryCrossings << G4endl;
+   G4cout << "   steps:                " << fNofSteps << G4endl;
+   G4cout << "     zero steps:         " << fNofZeroSteps << G4endl;
+   G4cout << "     abandoned:          " << fNofAbandonedSteps << G4endl;
+   G4cout << "   safety cache hits:    " << fNofSafetyHits;
+   if (nofSafeties) G4cout << " (" << 100.*fNofSafetyHits/nofSafeties << " %)";
+   G4cout << G4endl;
+   G4cout << "   safety sphere reuses: " << fNofSafetyReuses;
+   if (nofSafeties) G4cout << " (" << 100.*fNofSafetyReuses/nofSafeties << " %)";
+   G4cout << G4endl;
+   G4cout << "   safety cache misses:  " << fNofSafetyMisses << G4endl;
+   if (fNofSafetyCheckFailures) {
+      G4cout << "   safety check failures: " << fNofSafetyCheckFailures << G4endl;
+   }   
+}
+
+//______________________________________________________________________________
+void TG4RootNavStatistics::Reset()
+{
+/// Reset all counters.
+   *this = TG4RootNavStatistics();
+}
@@ -21,6 +21,8 @@
 
 #include "G4SystemOfUnits.hh"
 
+#include <cmath>
+
 
 //ClassImp(TG4RootNavigator)
 
@@ -29,6 +31,10 @@ static const double gCm = 1./cm;
 static const double gZeroStepThr = 1.e-3; // >1.e-4 limit in G4PropagatorInField
 static const int    gAbandonZeroSteps = 40; // <50 limit in G4PropagatorInField
 
+Bool_t   TG4RootNavigator::fgSafetyReuse = kFALSE;
+Double_t TG4RootNavigator::fgSafetyReuseFraction = 0.25;
+Bool_t   TG4RootNavigator::fgSafetyCheck = kFALSE;
+
 //______________________________________________________________________________
 TG4RootNavigator::TG4RootNavigator()
                  :G4Navigator(),
@@ -40,7 +46,10 @@ TG4RootNavigator::TG4RootNavigator()
                   fNextPoint(),
                   fSafetyOrig(),
                   fLastSafety(0),
-                  fNzeroSteps(0)
+                  fNzeroSteps(0),
+                  fIsSynchronized(kFALSE),
+                  fSyncNodes(),
+                  fStatistics()
 {
 /// Dummy ctor.
 }
@@ -56,7 +65,10 @@ TG4RootNavigator::TG4RootNavigator(TG4RootDetectorConstruction *dc)
                   fNextPoint(),
                   fSafetyOrig(),
                   fLastSafety(0),
-                  fNzeroSteps(0)
+                  fNzeroSteps(0),
+                  fIsSynchronized(kFALSE),
+                  fSyncNodes(),
+                  fStatistics()
 {
 /// Default ctor.
    fSafetyOrig.set(kInfinity, kInfinity, kInfinity);
@@ -109,12 +121,11 @@ G4double TG4RootNavigator::ComputeStep(const G4ThreeVector &pGlobalPoint,
 
    // The following 2 lines are not needed if G4 calls first LocateGlobalPoint...
 //   fGeometry->ResetState();
-   static Long64_t istep = 0;
-   istep++;
+   fStatistics.fNofSteps++;
    
 #ifdef G4ROOT_DEBUG
    G4cout.precision(8);
-   G4cout << "*** ComputeStep #" << istep << ": ***" <<
+   G4cout << "*** ComputeStep #" << fStatistics.fNofSteps << ": ***" <<
              fHistory.GetTopVolume()->GetName() << " entered: " << fEnteredDaughter << "  exited: " << fExitedMother << G4endl;
 #endif
    Double_t tol = 0.;
@@ -146,17 +157,19 @@ G4double TG4RootNavigator::ComputeStep(const G4ThreeVector &pGlobalPoint,
 #ifdef G4ROOT_DEBUG
          oldpoint = kTRUE;
 #endif
+         if (compute_safety) fStatistics.fNofSafetyHits++;
          compute_safety = kFALSE;
          pNewSafety = fLastSafety;
       }   
-      fSafetyOrig = pGlobalPoint;
    }   
    fNavigator->SetCurrentDirection(pDirection.x(), pDirection.y(), pDirection.z());
    fNavigator->FindNextBoundary(-(pstep*gCm-tol), "", !compute_safety);
 
    if (compute_safety) {
+      fStatistics.fNofSafetyMisses++;
       pNewSafety = (fNavigator->GetSafeDistance()-tol)*cm;
       if (pNewSafety<0.) pNewSafety = 0.;
+      fSafetyOrig = pGlobalPoint;
       fLastSafety = pNewSafety;
    }   
    G4double step = (fNavigator->GetStep()+tol)*cm;
@@ -164,11 +177,15 @@ G4double TG4RootNavigator::ComputeStep(const G4ThreeVector &pGlobalPoint,
    if (step < 1.e3*tol*cm) {
       step = 0.;
       fNzeroSteps++;
+      fStatistics.fNofZeroSteps++;
       // Geant4 will abandon the track if the number of zero steps>50 just
       // because it expects a non-zero distance inside the mother to the next daughter
       // The way out is to generate an extra very small fake step in the mother,
       // before this threshold is reached
-      if (fNzeroSteps > gAbandonZeroSteps) step = gZeroStepThr;
+      if (fNzeroSteps > gAbandonZeroSteps) {
+         step = gZeroStepThr;
+         fStatistics.fNofAbandonedSteps++;
+      }
    } else {
      fNzeroSteps = 0;
    }
@@ -215,6 +232,8 @@ G4VPhysicalVolume* TG4RootNavigator::ResetHierarchyAndLocate(
    G4cout.precision(12);
    G4cout << "ResetHierarchyAndLocate: POINT: " << point << " DIR: "<< direction << G4endl;
 #endif
+   fStatistics.fNofLocates++;
+   fStatistics.fNofFullLocates++;
    ResetState();
    fEnteredDaughter = kFALSE;
    fExitedMother = kFALSE;
@@ -232,87 +251,115 @@ TGeoNode *TG4RootNavigator::SynchronizeGeoManager()
 {
 /// Synchronize the current state of TGeoManager with the current navigation
 /// history. Do the minimum possible work in case 
-/// states are already (or almost) in sync. Returns current logical node.
+/// states are already (or almost) in sync: the history is compared with the
+/// nodes of the last synchronized state, the nodes are resolved only for the
+/// levels which changed and only the part of the TGeo path below the first
+/// level which differs from the history is updated. The daughter indices 
+/// recorded by the detector construction are used to step down, so the
+/// daughters lists need not to be searched.
+/// Returns current logical node.
    Int_t geolevel = fNavigator->GetLevel();
    Int_t depth = fHistory.GetDepth();
+   Int_t nsync = (fIsSynchronized) ? Int_t(fSyncNodes.size()) : 0;
    Int_t nodeIndex, level;
-   G4VPhysicalVolume *pvol;
-   TGeoNode *pnode, *newnode=0;
-   for (level=1; level<=depth; level++) {
-      pvol = fHistory.GetVolume(level);
-      newnode = fDetConstruction->GetNode(pvol);
-      if (level<=geolevel) {
-         // TGeo has also something at this level - check if it matches what is
-         // in fHistory
-         pnode = fNavigator->GetMother(geolevel-level);
-         // If the node at this level matches the one in the history, do nothing
-         if (pnode==newnode) continue;
-         // From this level down we need to update TGeo path.
-         while (geolevel >= level) {
-            fNavigator->CdUp();
-            geolevel--;
-         }
-         // Now TGeo is at level-1 and needs to update level
-         // this should be the index of the node to be used in CdDown(index)
-         nodeIndex = fNavigator->GetCurrentVolume()->GetIndex(newnode);
-         if (nodeIndex < 0) {
-            G4cerr << "SynchronizeGeoManager did not work (1)!!!" << G4endl;
-            return NULL;         
-         }
-//         nodeIndex = fHistory.GetReplicaNo(level);
-         fNavigator->CdDown(nodeIndex);
-         geolevel++;     // Should be equal to i now
-      } else {
-         // This level has to be synchronized
-         nodeIndex = fNavigator->GetCurrentVolume()->GetIndex(newnode);
-         if (nodeIndex < 0) {
-            G4cerr << "SynchronizeGeoManager did not work (2)!!!" << G4endl;
-            return NULL;         
-         }
-//         nodeIndex = fHistory.GetReplicaNo(level);
-         fNavigator->CdDown(nodeIndex);
-         geolevel++;     // Should be equal to i now
+   TGeoNode *newnode;
+   // Keep the nodes of the levels which did not change in the history
+   level = 0;
+   while (level<=depth && level<nsync &&
+          fDetConstruction->GetG4VPhysicalVolume(fSyncNodes[level])==fHistory.GetVolume(level)) level++;
+   // Resolve the nodes of the changed levels only
+   fSyncNodes.resize(depth+1);
+   for (; level<=depth; level++) {
+      fSyncNodes[level] = fDetConstruction->GetNode(fHistory.GetVolume(level));
+   }   
+   // Skip the levels where TGeo matches already the history
+   level = 1;
+   while (level<=depth && level<=geolevel && 
+          fNavigator->GetMother(geolevel-level)==fSyncNodes[level]) level++;
+   // From this level down we need to update TGeo path.
+   while (geolevel >= level) {
+      fNavigator->CdUp();
+      geolevel--;
+   }
+   // Now TGeo is at level-1 and needs to update the remaining levels
+   for (; level<=depth; level++) {
+      newnode = fSyncNodes[level];
+      // this should be the index of the node to be used in CdDown(index)
+      nodeIndex = fDetConstruction->GetDaughterIndex(newnode);
+      TGeoVolume *mother = fNavigator->GetCurrentVolume();
+      if (nodeIndex < 0 || nodeIndex >= mother->GetNdaughters() ||
+          mother->GetNode(nodeIndex) != newnode) {
+         nodeIndex = mother->GetIndex(newnode);
+      }   
+      if (nodeIndex < 0) {
+         G4cerr << "SynchronizeGeoManager did not work !!!" << G4endl;
+         fIsSynchronized = kFALSE;
+         return NULL;         
       }
+      fNavigator->CdDown(nodeIndex);
    }
+   fIsSynchronized = kTRUE;
    return fNavigator->GetCurrentNode();
 }          
       
+//______________________________________________________________________________
+Bool_t TG4RootNavigator::IsHistorySynchronized() const
+{
+/// Check if the nodes kept from the last synchronization still describe
+/// the current navigation history.
+   Int_t depth = fHistory.GetDepth();
+   if (!fIsSynchronized || Int_t(fSyncNodes.size()) != depth+1) return kFALSE;
+   return (fDetConstruction->GetG4VPhysicalVolume(fSyncNodes[depth]) == fHistory.GetTopVolume());
+}          
+      
 //______________________________________________________________________________
 G4VPhysicalVolume *TG4RootNavigator::SynchronizeHistory()
 {
 /// Synchronize the current navigation history according the state of TGeoManager
-/// Do the minimum possible work in case states are already (or almost) in sync.
+/// Do the minimum possible work in case states are already (or almost) in sync:
+/// the TGeo branch is compared with the nodes of the last synchronized state and
+/// only the changed levels of the history are updated.
 /// Returns current physical volume
    Int_t depth = fHistory.GetDepth();
    Int_t geolevel = fNavigator->GetLevel();
-   G4VPhysicalVolume *pvol, *pnewvol=0;
+   G4VPhysicalVolume *pnewvol=0;
    TGeoNode *pnode;
    Int_t level;
-   for (level=0; level<=geolevel; level++) {
+   if (!IsHistorySynchronized()) {
+      fSyncNodes.resize(depth+1);
+      for (level=0; level<=depth; level++) {
+         fSyncNodes[level] = fDetConstruction->GetNode(fHistory.GetVolume(level));
+      }
+   }
+   // Skip the levels which are in sync
+   level = 0;
+   while (level<=depth && level<=geolevel && 
+          fNavigator->GetMother(geolevel-level)==fSyncNodes[level]) level++;
+   // From this level down we need to update G4 history.
+   if (level<=depth) {
+      if (level) {
+         fHistory.BackLevel(depth-level+1);
+         // Now fHistory is at the level level-1 
+      } else {
+         // We need to refresh top level
+         pnode = fNavigator->GetMother(geolevel);
+         pnewvol = fDetConstruction->GetG4VPhysicalVolume(pnode);
+         fHistory.BackLevel(depth);
+         fHistory.SetFirstEntry(pnewvol);
+         fSyncNodes[0] = pnode;
+         level = 1;
+      }   
+   }
+   fSyncNodes.resize(level);
+   // The remaining levels have to be added to the current history.
+   for (; level<=geolevel; level++) {
       pnode = fNavigator->GetMother(geolevel-level);
       pnewvol = fDetConstruction->GetG4VPhysicalVolume(pnode);
-      if (level<=depth) {
-         pvol = fHistory.GetVolume(level);
-         // If the phys. volume at this level matches the one in the history, do nothing
-         if (pvol==pnewvol) continue;
-         // From this level down we need to update G4 history.
-         if (level) {
-            fHistory.BackLevel(depth-level+1);
-            // Now fHistory is at the level i-1 and needs to update level i
-            fHistory.NewLevel(pnewvol, kNormal, pnewvol->GetCopyNo());
-         } else {
-            // We need to refresh top level
-            fHistory.BackLevel(depth);
-            fHistory.SetFirstEntry(pnewvol);
-         }
-         depth = level;
-      } else {
-         // This level has to be added to the current history.
-         fHistory.NewLevel(pnewvol, kNormal, pnewvol->GetCopyNo());
-         depth++;     // depth=level
-      }
+      fHistory.NewLevel(pnewvol, kNormal, pnewvol->GetCopyNo());
+      fSyncNodes.push_back(pnode);
    }
-   if (depth > level-1) fHistory.BackLevel(depth-level+1);
+   fIsSynchronized = kTRUE;
+   pnewvol = fHistory.GetTopVolume();
    if (fNavigator->IsOutside()) pnewvol = NULL;
    return pnewvol;      
 }         
@@ -321,7 +368,7 @@ G4VPhysicalVolume *TG4RootNavigator::SynchronizeHistory()
 G4VPhysicalVolume* 
 TG4RootNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& globalPoint,
                                             const G4ThreeVector* pGlobalDirection,
-                                            const G4bool /*relativeSearch*/,
+                                            const G4bool relativeSearch,
                                             const G4bool ignoreDirection)
 {
 /// Locate the point in the hierarchy return 0 if outside
@@ -336,11 +383,10 @@ TG4RootNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& globalPoint,
 ///                     whether daughter of last mother directly 
 ///                     or daughter of that volume's ancestor.
 
-   static Long64_t ilocate = 0;
-   ilocate++;
+   fStatistics.fNofLocates++;
 #ifdef G4ROOT_DEBUG
    G4cout.precision(12);
-   G4cout << "LocateGlobalPointAndSetup #" << ilocate << ": point: " << globalPoint << G4endl;
+   G4cout << "LocateGlobalPointAndSetup #" << fStatistics.fNofLocates << ": point: " << globalPoint << G4endl;
 #endif
    fNavigator->SetCurrentPoint(globalPoint.x()*gCm, globalPoint.y()*gCm, globalPoint.z()*gCm);
    fEnteredDaughter = fExitedMother = kFALSE;
@@ -367,6 +413,7 @@ TG4RootNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& globalPoint,
    if (fNavigator->IsOutside()) G4cout << "   outside" << G4endl;
 #endif
    if (onBoundary) {
+      fStatistics.fNofBoundaryCrossings++;
       fEnteredDaughter = fStepEntering;
       fExitedMother    = fStepExiting;
       TGeoNode *skip = fNavigator->GetCurrentNode();
@@ -379,6 +426,8 @@ TG4RootNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& globalPoint,
       fNavigator->CrossBoundaryAndLocate(fStepEntering, skip);
    } else {   
 //      if (!relativeSearch) fNavigator->CdTop();
+      if (relativeSearch) fStatistics.fNofRelativeLocates++;
+      else                fStatistics.fNofFullLocates++;
       fNavigator->FindNode();
    }   
    G4VPhysicalVolume *target = SynchronizeHistory();
@@ -424,7 +473,7 @@ G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint,
 
 //______________________________________________________________________________
 G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint, 
-                                         const G4double /*pProposedMaxLength*/)
+                                         const G4double pProposedMaxLength)
 {
 /// Calculate the isotropic distance to the nearest boundary from the
 /// specified point in the global coordinate system. 
@@ -432,6 +481,15 @@ G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint,
 /// The value returned is usually an underestimate.  
 /// The proposed maximum length is used to avoid volume safety
 /// calculations.  The geometry must be closed.
+///
+/// If the safety reuse is activated (it is off by default, as the result
+/// may differ from the full computation, see SetSafetyReuse()) and 
+/// the point is inside the sphere of the last computed safety, the
+/// safety is estimated as the last safety minus the distance from the sphere
+/// origin. It is recomputed only if this estimate drops below the 
+/// fraction fgSafetyReuseFraction of the last safety or below the proposed 
+/// maximum length (if set). In the check mode the estimate is validated 
+/// against the full computation.
 
 /// TO CHANGE TGeoManager::Safety To take into account pProposedMaxLength
 ///   fEnteredDaughter = kFALSE;
@@ -450,11 +508,23 @@ G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint,
 #ifdef G4ROOT_DEBUG
       G4cout << "ComputeSafety: POINT not changed: " << globalpoint << " SKIPPED... oldsafe="<<fLastSafety << G4endl;
 #endif
+      fStatistics.fNofSafetyHits++;
       return fLastSafety;
    }   
-   fNavigator->ResetState();
-   fNavigator->SetCurrentPoint(globalpoint.x()*gCm, globalpoint.y()*gCm, globalpoint.z()*gCm);
-   G4double safety = fNavigator->Safety()*cm;
+   if (fgSafetyReuse && d2 < fLastSafety*fLastSafety) {
+      G4double safety = fLastSafety - std::sqrt(d2);
+      if (safety >= fgSafetyReuseFraction*fLastSafety &&
+          (safety >= pProposedMaxLength || pProposedMaxLength >= kInfinity)) {
+#ifdef G4ROOT_DEBUG
+         G4cout << "ComputeSafety: POINT in safety sphere: " << globalpoint << " safe = " << safety << G4endl;
+#endif
+         fStatistics.fNofSafetyReuses++;
+         if (fgSafetyCheck) CheckSafety(globalpoint, safety);
+         return safety;
+      }
+   }   
+   fStatistics.fNofSafetyMisses++;
+   G4double safety = ComputeTGeoSafety(globalpoint);
    fSafetyOrig = globalpoint;
    fLastSafety = safety;
 
@@ -465,6 +535,32 @@ G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint,
    return safety;
 }
    
+//______________________________________________________________________________
+G4double TG4RootNavigator::ComputeTGeoSafety(const G4ThreeVector &globalpoint)
+{
+/// Compute the safety at the given point with TGeo.
+   fNavigator->ResetState();
+   fNavigator->SetCurrentPoint(globalpoint.x()*gCm, globalpoint.y()*gCm, globalpoint.z()*gCm);
+   return fNavigator->Safety()*cm;
+}
+
+//______________________________________________________________________________
+void TG4RootNavigator::CheckSafety(const G4ThreeVector &globalpoint, G4double safety)
+{
+/// Validate the safety estimated from the safety sphere against the full
+/// computation; issue a warning if it is overestimated.
+   G4double fullSafety = ComputeTGeoSafety(globalpoint);
+   if (safety > fullSafety + TGeoShape::Tolerance()*cm) {
+      fStatistics.fNofSafetyCheckFailures++;
+      G4ExceptionDescription description;
+      description << "      " 
+         << "Reused safety " << safety << " mm > computed safety " 
+         << fullSafety << " mm at " << globalpoint;
+      G4Exception("TG4RootNavigator::CheckSafety",
+                  "G4Root_W001", JustWarning, description);
+   }
+}
+
 //______________________________________________________________________________
 G4TouchableHistoryHandle TG4RootNavigator::CreateTouchableHistoryHandle() const
 {
@@ -40,23 +40,77 @@ static const Double_t gCm = 1./cm;
 
 //______________________________________________________________________________
 TG4RootSolid::TG4RootSolid(TGeoShape *shape)
-             :G4VSolid(shape->GetName())
+             :G4VSolid(shape->GetName()),
+              fCubicVolume(-1.)
 {
 /// Constructor.
    fShape = shape;
 }
    
+#if G4VERSION_NUMBER >= 1030
 //______________________________________________________________________________
-G4bool TG4RootSolid::CalculateExtent(const EAxis /*pAxis*/,
-                                     const G4VoxelLimits& /*pVoxelLimit*/,
-				                         const G4AffineTransform& /*pTransform*/,
-				                         G4double& /*pMin*/, G4double& /*pMax*/) const
+void TG4RootSolid::BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const
+{
+/// Return the limits of the shape bounding box in the local frame.
+   TGeoBBox *box = (TGeoBBox*)fShape;
+   const Double_t *origin = box->GetOrigin();
+   G4ThreeVector halfLength(box->GetDX()*cm, box->GetDY()*cm, box->GetDZ()*cm);
+   G4ThreeVector center(origin[0]*cm, origin[1]*cm, origin[2]*cm);
+   pMin = center - halfLength;
+   pMax = center + halfLength;
+}
+#endif
+
+//______________________________________________________________________________
+G4bool TG4RootSolid::CalculateExtent(const EAxis pAxis,
+                                     const G4VoxelLimits& pVoxelLimit,
+				                         const G4AffineTransform& pTransform,
+				                         G4double& pMin, G4double& pMax) const
 {
 /// Calculate the minimum and maximum extent of the solid, when under the
 /// specified transform, and within the specified limits. If the solid
 /// is not intersected by the region, return false, else return true.
-   G4cout << "Warning: TG4RootSolid::CalculateExtent() not implemented" << G4endl;
-   return false;
+/// The extent is computed from the TGeo shape bounding box: the box corners
+/// are transformed and their axis-aligned extent is clipped by the limits.
+   Int_t iaxis;
+   switch (pAxis) {
+      case kXAxis: iaxis = 0; break;
+      case kYAxis: iaxis = 1; break;
+      case kZAxis: iaxis = 2; break;
+      default:
+         G4cout << "Warning: TG4RootSolid::CalculateExtent() supports only x, y, z axes" << G4endl;
+         return false;
+   }   
+   TGeoBBox *box = (TGeoBBox*)fShape;
+   const Double_t *origin = box->GetOrigin();
+   G4double dx = box->GetDX()*cm;
+   G4double dy = box->GetDY()*cm;
+   G4double dz = box->GetDZ()*cm;
+   G4double emin[3] = {kInfinity, kInfinity, kInfinity};
+   G4double emax[3] = {-kInfinity, -kInfinity, -kInfinity};
+   Int_t i, j;
+   for (i=0; i<8; i++) {
+      G4ThreeVector corner(origin[0]*cm + ((i&1) ? dx : -dx),
+                           origin[1]*cm + ((i&2) ? dy : -dy),
+                           origin[2]*cm + ((i&4) ? dz : -dz));
+      G4ThreeVector point = pTransform.TransformPoint(corner);
+      for (j=0; j<3; j++) {
+         if (point[j] < emin[j]) emin[j] = point[j];
+         if (point[j] > emax[j]) emax[j] = point[j];
+      }
+   }
+   const EAxis axes[3] = {kXAxis, kYAxis, kZAxis};
+   for (j=0; j<3; j++) {
+      if (!pVoxelLimit.IsLimited(axes[j])) continue;
+      G4double lmin = pVoxelLimit.GetMinExtent(axes[j]);
+      G4double lmax = pVoxelLimit.GetMaxExtent(axes[j]);
+      if (emax[j] < lmin - kCarTolerance || emin[j] > lmax + kCarTolerance) return false;
+      if (emin[j] < lmin) emin[j] = lmin;
+      if (emax[j] > lmax) emax[j] = lmax;
+   }
+   pMin = emin[iaxis] - kCarTolerance;
+   pMax = emax[iaxis] + kCarTolerance;
+   return true;
 }
    
 //______________________________________________________________________________
@@ -190,9 +244,13 @@ G4double TG4RootSolid::GetCubicVolume()
 /// This method may be overloaded by derived classes to compute the
 /// exact geometrical quantity for solids where this is possible,
 /// or anyway to cache the computed value.
-/// Note: the computed value is NOT cached.
-   G4double capacity = fShape->Capacity() * cm3;
-   return capacity;
+/// The value is computed from the TGeo shape capacity and cached; 
+/// if the capacity is not available, the G4 estimation is used.
+   if (fCubicVolume < 0.) {
+      fCubicVolume = fShape->Capacity() * cm3;
+      if (fCubicVolume <= 0.) fCubicVolume = G4VSolid::GetCubicVolume();
+   }   
+   return fCubicVolume;
 }
 
 //______________________________________________________________________________
@@ -0,0 +1,165 @@
+// @(#)root/g4root:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/// \file NavBench.cc
+/// \brief Navigation microbenchmark for G4Root
+///
+/// Measures the cost of the TGeoNode <-> G4VPhysicalVolume cross-reference
+/// lookups done by TG4RootNavigator at every locate, comparing the flat
+/// arrays of TG4RootDetectorConstruction with std::map lookups, and the
+/// time per TG4RootNavigator::LocateGlobalPointAndSetup() call for random
+/// points in the world volume.
+///
+/// Usage: g4root_NavBench [-g geometry.root] [-n nofPoints] [-r nofRepeats]
+
+#include "G4PhysicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ThreeVector.hh"
+#include "G4Timer.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+#include "globals.hh"
+
+#include "TGeoManager.h"
+#include "TGeoVolume.h"
+#include "TGeoBBox.h"
+#include "TGeoNode.h"
+#include "TG4RootDetectorConstruction.h"
+#include "TG4RootNavigator.h"
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+
+namespace {
+  void PrintUsage() {
+    G4cerr << " Usage: " << G4endl;
+    G4cerr << " g4root_NavBench [-g geometry.root] [-n nofPoints] [-r nofRepeats]"
+           << G4endl;
+  }
+}
+
+int main(int argc,char** argv)
+{
+  // Evaluate arguments
+  //
+  G4String geomFile = "OpNoviceGeom.root";
+  G4int nofPoints = 1000000;
+  G4int nofRepeats = 1000;
+  for ( G4int i=1; i<argc; i=i+2 ) {
+     if ( i+1 >= argc ) {
+       PrintUsage();
+       return 1;
+     }
+     if      ( G4String(argv[i]) == "-g" ) geomFile   = argv[i+1];
+     else if ( G4String(argv[i]) == "-n" ) nofPoints  = atoi(argv[i+1]);
+     else if ( G4String(argv[i]) == "-r" ) nofRepeats = atoi(argv[i+1]);
+     else {
+       PrintUsage();
+       return 1;
+     }
+  }
+
+  // Build the G4 geometry from TGeo
+  //
+  TGeoManager *geom = TGeoManager::Import(geomFile.c_str());
+  if ( ! geom ) {
+    G4cerr << "Cannot import geometry from " << geomFile << G4endl;
+    return 1;
+  }
+  TG4RootDetectorConstruction *dc = new TG4RootDetectorConstruction(geom);
+  dc->Initialize();
+  TG4RootNavigator *nav = new TG4RootNavigator(dc);
+
+  // Collect the cross-references and fill the reference maps
+  //
+  std::vector<G4VPhysicalVolume*> pvs;
+  std::vector<TGeoNode*> nodes;
+  std::map<const TGeoNode*, G4VPhysicalVolume*> pvMap;
+  std::map<const G4VPhysicalVolume*, TGeoNode*> nodeMap;
+  G4PhysicalVolumeStore *pvStore = G4PhysicalVolumeStore::GetInstance();
+  for ( size_t i=0; i<pvStore->size(); ++i ) {
+    G4VPhysicalVolume *pv = (*pvStore)[i];
+    TGeoNode *node = dc->GetNode(pv);
+    if ( ! node ) continue;
+    if ( dc->GetG4VPhysicalVolume(node) != pv ) {
+      G4cerr << "Inconsistent cross-reference for " << pv->GetName() << G4endl;
+      return 1;
+    }
+    pvs.push_back(pv);
+    nodes.push_back(node);
+    pvMap[node] = pv;
+    nodeMap[pv] = node;
+  }
+  G4cout << "Number of physical volumes: " << pvs.size() << G4endl;
+
+  // Cross-reference lookups
+  //
+  G4Timer timer;
+  size_t nofLookups = 2*pvs.size()*nofRepeats;
+  size_t check = 0;
+
+  timer.Start();
+  for ( G4int ir=0; ir<nofRepeats; ++ir ) {
+    for ( size_t i=0; i<pvs.size(); ++i ) {
+      check += ( pvMap.find(nodes[i])->second == pvs[i] );
+      check += ( nodeMap.find(pvs[i])->second == nodes[i] );
+    }
+  }
+  timer.Stop();
+  G4double mapTime = timer.GetRealElapsed();
+
+  timer.Start();
+  for ( G4int ir=0; ir<nofRepeats; ++ir ) {
+    for ( size_t i=0; i<pvs.size(); ++i ) {
+      check += ( dc->GetG4VPhysicalVolume(nodes[i]) == pvs[i] );
+      check += ( dc->GetNode(pvs[i]) == nodes[i] );
+    }
+  }
+  timer.Stop();
+  G4double arrayTime = timer.GetRealElapsed();
+
+  if ( check != 2*nofLookups ) {
+    G4cerr << "Lookup results differ" << G4endl;
+    return 1;
+  }
+  if ( nofLookups ) {
+    G4cout << "Lookups (" << nofLookups << "):  std::map "
+           << mapTime/nofLookups*1.e9 << " ns,  flat arrays "
+           << arrayTime/nofLookups*1.e9 << " ns per lookup" << G4endl;
+  }
+
+  // Locate random points in the world bounding box
+  //
+  TGeoBBox *box = (TGeoBBox*)geom->GetTopVolume()->GetShape();
+  const Double_t *origin = box->GetOrigin();
+  std::vector<G4ThreeVector> points(nofPoints);
+  for ( G4int i=0; i<nofPoints; ++i ) {
+    points[i].set(
+      (origin[0] + box->GetDX()*(2.*G4UniformRand()-1.))*cm,
+      (origin[1] + box->GetDY()*(2.*G4UniformRand()-1.))*cm,
+      (origin[2] + box->GetDZ()*(2.*G4UniformRand()-1.))*cm);
+  }
+
+  G4int nofInside = 0;
+  timer.Start();
+  for ( G4int i=0; i<nofPoints; ++i ) {
+    if ( nav->LocateGlobalPointAndSetup(points[i]) ) ++nofInside;
+  }
+  timer.Stop();
+  if ( nofPoints ) {
+    G4cout << "Locates (" << nofPoints << ", " << nofInside << " inside): "
+           << timer.GetRealElapsed()/nofPoints*1.e9 << " ns per locate" << G4endl;
+  }
+
+  delete nav;
+  delete dc;
+  return 0;
+}
@@ -0,0 +1,154 @@
+// @(#)root/g4root:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/// \file VoxelTest.cc
+/// \brief Test of the G4 smart voxels built on a TGeo-converted geometry
+///
+/// For each G4 logical volume with daughters created by
+/// TG4RootDetectorConstruction the test checks that:
+///  - TG4RootSolid::CalculateExtent() gives a valid extent for all daughters,
+///  - G4SmartVoxelHeader can be built and each daughter is contained
+///    in at least one voxel node,
+/// and that TG4RootSolid::GetCubicVolume() is positive for all solids.
+/// Finally the geometry is closed with the voxels optimisation.
+///
+/// Usage: g4root_VoxelTest [-g geometry.root]
+
+#include "G4LogicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4VisExtent.hh"
+#include "G4AffineTransform.hh"
+#include "G4VoxelLimits.hh"
+#include "G4SmartVoxelHeader.hh"
+#include "G4SmartVoxelProxy.hh"
+#include "G4SmartVoxelNode.hh"
+#include "G4GeometryManager.hh"
+#include "globals.hh"
+
+#include "TGeoManager.h"
+#include "TG4RootDetectorConstruction.h"
+
+#include <set>
+
+namespace {
+  void PrintUsage() {
+    G4cerr << " Usage: " << G4endl;
+    G4cerr << " g4root_VoxelTest [-g geometry.root]" << G4endl;
+  }
+
+  // Collect the daughters contained in the voxel nodes of the given header
+  void CollectContained(const G4SmartVoxelHeader* header, std::set<G4int>& contained) {
+    for ( size_t i=0; i<header->GetNoSlices(); ++i ) {
+      G4SmartVoxelProxy* proxy = header->GetSlice(i);
+      if ( proxy->IsNode() ) {
+        G4SmartVoxelNode* node = proxy->GetNode();
+        for ( G4int j=0; j<node->GetNoContained(); ++j ) {
+          contained.insert(node->GetVolume(j));
+        }
+      }
+      else {
+        CollectContained(proxy->GetHeader(), contained);
+      }
+    }
+  }
+}
+
+int main(int argc,char** argv)
+{
+  // Evaluate arguments
+  //
+  G4String geomFile = "OpNoviceGeom.root";
+  for ( G4int i=1; i<argc; i=i+2 ) {
+     if ( i+1 < argc && G4String(argv[i]) == "-g" ) {
+       geomFile = argv[i+1];
+     }
+     else {
+       PrintUsage();
+       return 1;
+     }
+  }
+
+  // Build the G4 geometry from TGeo
+  //
+  TGeoManager *geom = TGeoManager::Import(geomFile.c_str());
+  if ( ! geom ) {
+    G4cerr << "Cannot import geometry from " << geomFile << G4endl;
+    return 1;
+  }
+  TG4RootDetectorConstruction *dc = new TG4RootDetectorConstruction(geom);
+  dc->Initialize();
+
+  G4int nofErrors = 0;
+  G4int nofHeaders = 0;
+  G4LogicalVolumeStore *lvStore = G4LogicalVolumeStore::GetInstance();
+  for ( size_t i=0; i<lvStore->size(); ++i ) {
+    G4LogicalVolume *lv = (*lvStore)[i];
+
+    // Cubic volume
+    if ( lv->GetSolid()->GetCubicVolume() <= 0. ) {
+      G4cerr << "Wrong cubic volume of " << lv->GetName() << G4endl;
+      ++nofErrors;
+    }
+
+    G4int nofDaughters = lv->GetNoDaughters();
+    if ( ! nofDaughters ) continue;
+
+    // Extent of daughters in the mother frame
+    G4VoxelLimits limits;
+    for ( G4int j=0; j<nofDaughters; ++j ) {
+      G4VPhysicalVolume *pv = lv->GetDaughter(j);
+      G4VSolid *solid = pv->GetLogicalVolume()->GetSolid();
+      G4AffineTransform transform(pv->GetRotation(), pv->GetTranslation());
+      G4ThreeVector center 
+        = transform.TransformPoint(solid->GetExtent().GetExtentCentre());
+      for ( G4int k=0; k<3; ++k ) {
+        EAxis axis = (k == 0) ? kXAxis : ( (k == 1) ? kYAxis : kZAxis );
+        G4double pMin, pMax;
+        if ( ! solid->CalculateExtent(axis, limits, transform, pMin, pMax) ||
+             pMin >= pMax || center[k] < pMin || center[k] > pMax ) {
+          G4cerr << "Wrong extent of " << pv->GetName() << " along axis " << k
+                 << " in " << lv->GetName() << G4endl;
+          ++nofErrors;
+        }
+      }
+    }
+
+    // Smart voxels
+    G4SmartVoxelHeader header(lv);
+    std::set<G4int> contained;
+    CollectContained(&header, contained);
+    G4cout << lv->GetName() << ": " << nofDaughters << " daughters, "
+           << header.GetNoSlices() << " slices along axis " << header.GetAxis()
+           << G4endl;
+    if ( ! header.GetNoSlices() || G4int(contained.size()) != nofDaughters ) {
+      G4cerr << "Wrong smart voxels in " << lv->GetName() << ": "
+             << contained.size() << " daughters found in voxels" << G4endl;
+      ++nofErrors;
+    }
+    ++nofHeaders;
+  }
+
+  // Close geometry with voxels optimisation
+  //
+  G4GeometryManager::GetInstance()->CloseGeometry(true, true);
+  G4GeometryManager::GetInstance()->OpenGeometry();
+
+  G4cout << "Number of tested voxel headers: " << nofHeaders << G4endl;
+  if ( nofErrors ) {
+    G4cerr << "VoxelTest failed with " << nofErrors << " errors" << G4endl;
+    return 1;
+  }
+  G4cout << "VoxelTest passed" << G4endl;
+
+  delete dc;
+  return 0;
+}
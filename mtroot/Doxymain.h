@@ -22,4 +22,9 @@ and also
    Can be used by applications to implement in a portable way a mutexing logic.
    It was extracted from G4AutoLock implementation for Linux platforms.
 
+and the optional VMC stack interface
+
+  - TVirtualMCStackWithKeepFlag - for stacks supporting the reuse of the slots
+   of tracks which need not be kept.
+
 */
@@ -0,0 +1,84 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TVirtualMCStackWithKeepFlag.h
+/// \brief Definition of the TVirtualMCStackWithKeepFlag class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#ifndef ROOT_TVirtualMCStackWithKeepFlag
+#define ROOT_TVirtualMCStackWithKeepFlag
+
+#include <Rtypes.h>
+#include <TMCProcess.h>
+
+/// \brief The optional interface for VMC stacks supporting the reuse 
+/// of the stack slots of the tracks which need not be kept.
+///
+/// A user VMC stack can inherit from this class in addition to 
+/// TVirtualMCStack. When the overwriting of tracks is activated in the MC, 
+/// the MC may call OverwriteLastTrack() instead of TVirtualMCStack::PushTrack()
+/// to store a new secondary track in the slot of the last track in the stack.
+///
+/// The MC guarantees that it overwrites the last track only if:
+/// - it is a secondary track which was pushed in the stack when it started
+///   tracking, and its tracking is finished;
+/// - it has not produced any secondary particles, and so no other track
+///   refers to it as a mother;
+/// - it was not flagged to be kept via SetKeepCurrentTrack(kTRUE) while 
+///   it was the current track.
+///
+/// The user code has to flag the current track to be kept if it refers 
+/// to it (e.g. by storing its index in a hit). 
+/// The stack implementation has to keep the track index unchanged
+/// (GetNtrack() does not change) and reset the keep flag when the current
+/// track changes.
+///
+/// The class is header-only so that it can be implemented in the 
+/// MC independent user code without linking an additional library.
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+class TVirtualMCStackWithKeepFlag
+{
+  public:
+    /// Default constructor
+    TVirtualMCStackWithKeepFlag() {}
+    /// Destructor
+    virtual ~TVirtualMCStackWithKeepFlag() {}
+
+    // methods
+
+    /// Replace the last track in the stack with the new track;
+    /// the arguments have the same meaning as in TVirtualMCStack::PushTrack()
+    virtual void  OverwriteLastTrack(Int_t toBeDone, Int_t parent, Int_t pdg,
+                      Double_t px, Double_t py, Double_t pz, Double_t e,
+                      Double_t vx, Double_t vy, Double_t vz, Double_t tof,
+                      Double_t polx, Double_t poly, Double_t polz,
+                      TMCProcess mech, Int_t& ntr, Double_t weight,
+                      Int_t is) = 0;
+
+    // set methods
+
+    /// Flag the current track to be kept (it will not be overwritten)
+    virtual void  SetKeepCurrentTrack(Bool_t keep) = 0;
+
+    // get methods
+
+    /// Return true if the current track is flagged to be kept
+    virtual Bool_t  GetKeepCurrentTrack() const = 0;
+
+  private:
+    /// Not implemented
+    TVirtualMCStackWithKeepFlag(const TVirtualMCStackWithKeepFlag& rhs);
+    /// Not implemented
+    TVirtualMCStackWithKeepFlag& operator=(const TVirtualMCStackWithKeepFlag& rhs);
+};
+
+#endif //ROOT_TVirtualMCStackWithKeepFlag
@@ -19,10 +19,13 @@
 #include "TG4SDMessenger.h"
 
 #include <set>
+#include <map>
 
 class G4LogicalVolume;
 
 class TVirtualMCSensitiveDetector;
+class TG4VScoringHandler;
+class TG4SDFilter;
 
 /// \ingroup digits_hits
 /// \class TG4SDConstruction
@@ -56,10 +59,16 @@ class TG4SDConstruction : public TG4Verbose
     void SetSensitiveVolumeLabel(const G4String& label);
     void SetIsGflash(G4bool isGflash);
 
+    // step filters
+    TG4SDFilter* GetOrCreateFilter(const G4String& volumeName);
+    TG4SDFilter* GetFilter(const G4String& volumeName) const;
+    void PrintFilters() const;
+
   private:
     // methods
     void  CreateSD(G4LogicalVolume* lv,
-                   TVirtualMCSensitiveDetector* userSD) const;
+                   TVirtualMCSensitiveDetector* userSD,
+                   TG4VScoringHandler* scoringHandler = 0) const;
     void  FillSDSelectionFromTGeo();
     void  MapVolumesToInstanceIds();
     void  MapVolumesToSDIds();
@@ -83,6 +92,9 @@ class TG4SDConstruction : public TG4Verbose
 
     /// the flag to acivate creating Gflash sensitive detectors
     G4bool             fIsGflash;
+
+    /// the step filters per volume name
+    std::map<G4String, TG4SDFilter*>  fFilters;
 };
 
 // inline functions
@@ -0,0 +1,103 @@
+#ifndef TG4_SD_FILTER_H
+#define TG4_SD_FILTER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4SDFilter.h
+/// \brief Definition of the TG4SDFilter class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include <globals.hh>
+
+#include <set>
+
+class G4Track;
+
+/// \ingroup digits_hits
+/// \brief The step filter applied in TG4SensitiveDetector before calling
+/// the user code.
+///
+/// The filter rejects the steps with the energy deposit below a given value,
+/// the steps of neutral particles (if charged only is set), the steps 
+/// with the kinetic energy at the step start out of a given window and
+/// the steps of particles which are not in the included PDG set (if this set
+/// is not empty) or which are in the excluded PDG set.
+///
+/// The same criteria are applied to all steps passed to the user code:
+/// the normal steps, the steps on the geometrical boundary and the track
+/// start. The energy deposit is the one seen by the user via 
+/// TVirtualMC::Edep(), which is zero at the track start and on the boundary
+/// (except for the optical photons detection), so these steps are rejected
+/// when a minimum energy deposit is set. The kinetic energy is taken 
+/// at the pre-step point for the normal steps, at the boundary and at 
+/// the track vertex for the other steps.
+///
+/// The filters are defined per volume name in TG4SDConstruction
+/// via the C++ interface or the /mcDet/setSDFilter* commands.
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+class TG4SDFilter
+{
+  public:
+    TG4SDFilter();
+    ~TG4SDFilter();
+
+    // methods
+    G4bool Accept(const G4Track* track, G4double ekin, G4double edep) const;
+    void   Print(const G4String& volumeName) const;
+
+    // set methods
+    void SetMinEdep(G4double minEdep);
+    void SetChargedOnly(G4bool chargedOnly);
+    void SetEkinRange(G4double minEkin, G4double maxEkin);
+    void AddIncludedPdg(G4int pdg);
+    void AddExcludedPdg(G4int pdg);
+
+  private:
+    // data members
+    G4double  fMinEdep;     ///< minimum energy deposit
+    G4bool    fChargedOnly; ///< option to accept only charged particles
+    G4double  fMinEkin;     ///< minimum kinetic energy
+    G4double  fMaxEkin;     ///< maximum kinetic energy
+    std::set<G4int>  fIncludedPdgs; ///< accepted PDG codes (all if empty)
+    std::set<G4int>  fExcludedPdgs; ///< rejected PDG codes
+};
+
+// inline methods
+
+inline void TG4SDFilter::SetMinEdep(G4double minEdep) {
+  /// Set the minimum energy deposit (in Geant4 units)
+  fMinEdep = minEdep;
+}
+
+inline void TG4SDFilter::SetChargedOnly(G4bool chargedOnly) {
+  /// Set the option to accept only steps of charged particles
+  fChargedOnly = chargedOnly;
+}
+
+inline void TG4SDFilter::SetEkinRange(G4double minEkin, G4double maxEkin) {
+  /// Set the kinetic energy window (in Geant4 units)
+  fMinEkin = minEkin; fMaxEkin = maxEkin;
+}
+
+inline void TG4SDFilter::AddIncludedPdg(G4int pdg) {
+  /// Add the PDG code in the set of accepted particles
+  fIncludedPdgs.insert(pdg);
+}
+
+inline void TG4SDFilter::AddExcludedPdg(G4int pdg) {
+  /// Add the PDG code in the set of rejected particles
+  fExcludedPdgs.insert(pdg);
+}
+
+#endif //TG4_SD_FILTER_H
+
@@ -21,6 +21,7 @@
 
 class TG4SDServices;
 class TG4SDConstruction;
+class TG4VScoringHandler;
 
 class TVirtualMCSensitiveDetector;
 
@@ -54,6 +55,8 @@ class TG4SDManager
     void SetSensitiveDetector(const TString& volName, TVirtualMCSensitiveDetector* sd);
     TVirtualMCSensitiveDetector* GetSensitiveDetector(const TString& volName) const;
     void SetExclusiveSDScoring(Bool_t exclusiveSDScoring);
+    void SetScoringHandler(const TString& volName, 
+                           TG4VScoringHandler* handler); // G4 specific
 
     // get methods
     TG4SDConstruction* GetSDConstruction() const;
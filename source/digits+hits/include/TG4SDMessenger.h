@@ -23,6 +23,7 @@ class TG4SDConstruction;
 class G4UIcmdWithAString;
 class G4UIcmdWithABool;
 class G4UIcmdWithoutParameter;
+class G4UIcommand;
 
 /// \ingroup physics_list
 /// \brief Messenger class that defines commands for the SD construction
@@ -34,6 +35,12 @@ class G4UIcmdWithoutParameter;
 /// - /mcDet/setGflash  true|false
 /// - /mcDet/setExclusiveSDScoring true|false
 /// - /mcDet/printUserSDs
+/// - /mcDet/setSDFilterMinEdep volName edep
+/// - /mcDet/setSDFilterChargedOnly volName true|false
+/// - /mcDet/setSDFilterEkinRange volName ekinMin [ekinMax]
+/// - /mcDet/addSDFilterPdg volName pdg1 [pdg2 ...]
+/// - /mcDet/addSDFilterExcludedPdg volName pdg1 [pdg2 ...]
+/// - /mcDet/printSDFilters
 ///
 /// \author I. Hrivnacova; IPN Orsay
 
@@ -54,6 +61,9 @@ class TG4SDMessenger: public G4UImessenger
     /// Not implemented
     TG4SDMessenger& operator=(const TG4SDMessenger& right);
 
+    // methods
+    void CreateSDFilterCmds();
+
     //
     // data members
     
@@ -77,6 +87,24 @@ class TG4SDMessenger: public G4UImessenger
 
     /// command: printVolumes
     G4UIcmdWithoutParameter*  fPrintUserSDsCmd;
+
+    /// setSDFilterMinEdep command
+    G4UIcommand*  fSetSDFilterMinEdepCmd;
+
+    /// setSDFilterChargedOnly command
+    G4UIcommand*  fSetSDFilterChargedOnlyCmd;
+
+    /// setSDFilterEkinRange command
+    G4UIcommand*  fSetSDFilterEkinRangeCmd;
+
+    /// addSDFilterPdg command
+    G4UIcommand*  fAddSDFilterPdgCmd;
+
+    /// addSDFilterExcludedPdg command
+    G4UIcommand*  fAddSDFilterExcludedPdgCmd;
+
+    /// printSDFilters command
+    G4UIcmdWithoutParameter*  fPrintSDFiltersCmd;
 };
 
 #endif //TG4_SD_MESSENGER_H
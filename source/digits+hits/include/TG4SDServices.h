@@ -15,14 +15,19 @@
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
+#include "TG4VolumeDescriptor.h"
+
 #include <globals.hh>
+#include <G4LogicalVolume.hh>
 
 #include <Rtypes.h>
 
 #include <set>
 #include <map>
+#include <vector>
 
 class TG4SensitiveDetector;
+class TG4VScoringHandler;
 
 class G4LogicalVolume;
 class G4VSensitiveDetector;
@@ -51,6 +56,9 @@ class TG4SDServices
     // methods
     void MapVolume(G4LogicalVolume* lv, G4int id, G4bool fillLVToVolIdMap);
     void MapUserSD(const G4String& volumeName, TVirtualMCSensitiveDetector* userSD);
+    void MapScoringHandler(const G4String& volumeName, 
+                           TG4VScoringHandler* handler);
+    void MapVolumeDescriptors();
     void PrintStatistics(G4bool open, G4bool close) const;
     void PrintVolNameToIdMap() const;
     void PrintVolIdToLVMap() const;
@@ -68,7 +76,9 @@ class TG4SDServices
     G4String         GetVolumeName(G4int volumeId) const;
     G4LogicalVolume* GetLogicalVolume(G4int volumeId, G4bool warn = true) const;   
     G4int            GetMediumId(G4int volumeId) const;
+    const TG4VolumeDescriptor* GetVolumeDescriptor(G4LogicalVolume* volume) const;
     TVirtualMCSensitiveDetector* GetUserSD(G4String volumeName, G4bool warn = true) const;
+    TG4VScoringHandler* GetScoringHandler(const G4String& volumeName) const;
     G4bool  GetIsStopRun() const; 
           // SDs
     Int_t NofSensitiveDetectors() const; 
@@ -108,8 +118,14 @@ class TG4SDServices
     /// map volume name -> user SD
     static G4ThreadLocal std::map<G4String, TVirtualMCSensitiveDetector*>*  fgUserSDMap;
 
+    /// map volume name -> user scoring handler
+    static G4ThreadLocal std::map<G4String, TG4VScoringHandler*>*  fgScoringHandlerMap;
+
     /// info about user SDs
     G4bool fIsUserSDs;
+
+    /// volume descriptors indexed by logical volume instance ID
+    std::vector<TG4VolumeDescriptor>  fVolumeDescriptors;
 };
 
 // inline methods
@@ -134,6 +150,16 @@ inline G4bool TG4SDServices::GetIsStopRun() const {
   return fIsStopRun; 
 }
 
+inline const TG4VolumeDescriptor*
+TG4SDServices::GetVolumeDescriptor(G4LogicalVolume* volume) const {
+  /// Return the volume descriptor for the given logical volume
+  /// or 0 if the descriptor is not available
+  size_t index = volume->GetInstanceID();
+  if ( index >= fVolumeDescriptors.size() ||
+       ! fVolumeDescriptors[index].IsValid() ) return 0;
+  return &fVolumeDescriptors[index];
+}
+
 inline std::set<TVirtualMCSensitiveDetector*>* TG4SDServices::GetUserSDs() const {
   /// Returns the user SD vector
   return fgUserSDs;
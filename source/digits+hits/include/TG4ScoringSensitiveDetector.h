@@ -0,0 +1,147 @@
+#ifndef TG4_SCORING_SENSITIVE_DETECTOR_H
+#define TG4_SCORING_SENSITIVE_DETECTOR_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4ScoringSensitiveDetector.h
+/// \brief Definition of the TG4ScoringSensitiveDetector class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4SensitiveDetector.h"
+
+#include <globals.hh>
+
+#include <vector>
+#include <unordered_map>
+
+class TG4VScoringHandler;
+
+class G4HCofThisEvent;
+
+/// \ingroup digits_hits
+/// \brief Sensitive detector which sums the energy deposit and the step
+/// length per volume ID and copy number.
+///
+/// Unlike TG4SensitiveDetector, it does not call any user code per step.
+/// The accumulated values are kept in columns (volume IDs, copy numbers,
+/// energy deposits, step lengths) in G3 units and they are passed to 
+/// the user scoring handler (see TG4VScoringHandler) at the end of event.
+///
+/// The cells for copy numbers below the handler nofDenseCopies are found
+/// via a preallocated flat array, the other ones via a hash map.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4ScoringSensitiveDetector : public TG4SensitiveDetector
+{
+  public:
+    TG4ScoringSensitiveDetector(G4String sdName, G4int mediumID,
+                                TG4VScoringHandler* handler);
+    virtual ~TG4ScoringSensitiveDetector();
+
+    // methods
+    virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory* history);
+    virtual G4bool ProcessHitsOnBoundary(G4Step* step);
+    virtual void ProcessHitsOnTrackStart();
+    virtual void EndOfEvent(G4HCofThisEvent* hce);
+
+    // get methods
+    TG4VScoringHandler* GetHandler() const;
+    G4int GetNofCells() const;
+    const std::vector<G4int>&    GetVolumeIDs() const;
+    const std::vector<G4int>&    GetCopyNos() const;
+    const std::vector<G4double>& GetEdeps() const;
+    const std::vector<G4double>& GetStepLengths() const;
+
+  private:
+    /// Not implemented
+    TG4ScoringSensitiveDetector(); 
+    /// Not implemented
+    TG4ScoringSensitiveDetector(const TG4ScoringSensitiveDetector& right);
+    /// Not implemented
+    TG4ScoringSensitiveDetector& operator=(
+                                  const TG4ScoringSensitiveDetector &right);
+
+    // methods
+    G4int GetCell(G4int volumeID, G4int copyNo);
+    G4int AddCell(G4int volumeID, G4int copyNo, G4int denseIndex);
+    void  Reset();
+
+    // data members
+    /// user scoring handler
+    TG4VScoringHandler*  fHandler;
+
+    /// the number of copies accumulated via the flat array
+    G4int  fNofDenseCopies;
+
+    /// volume IDs with a slot in the flat array 
+    std::vector<G4int>  fDenseVolumeIDs;
+
+    /// the flat array: (volume slot, copy number) -> cell index or -1
+    std::vector<G4int>  fDenseCells;
+
+    /// hash map: (volume ID, copy number) -> cell index
+    std::unordered_map<G4long, G4int>  fSparseCells;
+
+    /// index in the flat array for each cell (or -1)
+    std::vector<G4int>    fCellDenseIndices;
+
+    /// the volume ID of each cell
+    std::vector<G4int>    fVolumeIDs;
+
+    /// the copy number of each cell
+    std::vector<G4int>    fCopyNos;
+
+    /// the accumulated energy deposit of each cell
+    std::vector<G4double> fEdeps;
+
+    /// the accumulated step length of each cell
+    std::vector<G4double> fStepLengths;
+};
+
+// inline methods
+
+inline TG4VScoringHandler* TG4ScoringSensitiveDetector::GetHandler() const {
+  /// Return the user scoring handler
+  return fHandler;
+}
+
+inline G4int TG4ScoringSensitiveDetector::GetNofCells() const {
+  /// Return the number of cells with accumulated values
+  return fVolumeIDs.size();
+}
+
+inline const std::vector<G4int>& 
+TG4ScoringSensitiveDetector::GetVolumeIDs() const {
+  /// Return the volume IDs of the cells
+  return fVolumeIDs;
+}
+
+inline const std::vector<G4int>& 
+TG4ScoringSensitiveDetector::GetCopyNos() const {
+  /// Return the copy numbers of the cells
+  return fCopyNos;
+}
+
+inline const std::vector<G4double>& 
+TG4ScoringSensitiveDetector::GetEdeps() const {
+  /// Return the accumulated energy deposits of the cells (in GeV)
+  return fEdeps;
+}
+
+inline const std::vector<G4double>& 
+TG4ScoringSensitiveDetector::GetStepLengths() const {
+  /// Return the accumulated step lengths of the cells (in cm)
+  return fStepLengths;
+}
+
+#endif //TG4_SCORING_SENSITIVE_DETECTOR_H
+
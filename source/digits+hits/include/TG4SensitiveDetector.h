@@ -19,6 +19,10 @@
 #include <globals.hh>
 
 class TG4StepManager;
+class TG4TrackManager;
+class TG4SDFilter;
+
+class G4Track;
 
 class TVirtualMCApplication;
 class TVirtualMCSensitiveDetector;
@@ -32,6 +36,13 @@ class TVirtualMCSensitiveDetector;
 /// and passing G4Step to TG4StepManager and for calling a user defined
 /// stepping function either via a user MC application stepping function
 /// or a user defined VMC sensitive detector (new).
+/// The steps can be pre-selected with a step filter (see TG4SDFilter and
+/// SetStepFilter()), the rejected steps are not passed to the user code.
+/// The step filter is independent from the Geant4 G4VSDFilter, which can 
+/// still be set via G4VSensitiveDetector::SetFilter().
+/// The tracks not saved by the track save policy are saved in the VMC stack
+/// before their first accepted step is processed, if the policy requires it
+/// (see TG4TrackSavePolicy).
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -52,21 +63,30 @@ class TG4SensitiveDetector : public G4VSensitiveDetector
     // static get method
     static G4int GetTotalNofSensitiveDetectors();
     
+    // set methods
+    void  SetStepFilter(const TG4SDFilter* filter);
+
     // get methods
     G4int GetID() const;
     G4int GetMediumID() const;
     TVirtualMCSensitiveDetector* GetUserSD() const;
+    const TG4SDFilter* GetStepFilter() const;
     
   protected:
+    void  SaveDroppedTrack(const G4Track* track);
     void  UserProcessHits();
 
     // data members
     /// Cached pointer to thread-local step manager
     TG4StepManager*  fStepManager;
+    /// Cached pointer to thread-local track manager
+    TG4TrackManager*  fTrackManager;
     /// Cached pointer to thread-local VMC application
     TVirtualMCApplication*  fMCApplication;
     /// User sensitive detector
     TVirtualMCSensitiveDetector*  fUserSD;
+    /// The step filter (not owned)
+    const TG4SDFilter*  fStepFilter;
 
   private:
     /// Not implemented
@@ -108,6 +128,16 @@ inline TVirtualMCSensitiveDetector* TG4SensitiveDetector::GetUserSD() const {
   return fUserSD;
 }
 
+inline void TG4SensitiveDetector::SetStepFilter(const TG4SDFilter* filter) {
+  /// Set the step filter
+  fStepFilter = filter;
+}
+
+inline const TG4SDFilter* TG4SensitiveDetector::GetStepFilter() const {
+  /// Returns the step filter
+  return fStepFilter;
+}
+
 #endif //TG4_SENSITIVE_DETECTOR_H
 
 
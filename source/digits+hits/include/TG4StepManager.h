@@ -18,20 +18,25 @@
 #include <Rtypes.h>
 
 #include "TG4StepStatus.h"
+#include "TG4StepRecord.h"
 
 #include <G4Step.hh>
 #include <G4GFlashSpot.hh>
 #include <G4TransportationManager.hh>
 #include <G4SteppingManager.hh>
 #include <G4ThreeVector.hh>
+#include <G4AffineTransform.hh>
 #include <globals.hh>
 
 #include <TString.h>
 #include <TArrayI.h>
 #include <TMCProcess.h>
 
+#include <vector>
+
 class TG4Limits;
 class TG4TrackManager;
+class TG4SDServices;
 class TG4SteppingAction;
 
 class G4Track;
@@ -75,6 +80,7 @@ class TG4StepManager
     void SetMaxNStep(Int_t maxNofSteps); 
     void SetCollectTracks(Bool_t collectTracks);
     void ForceDecayTime(Float_t pdg);
+    static void SetStepRecordNofLevels(G4int nofLevels); // G4 specific
     
     // get methods
     G4Track* GetTrack() const;                            // G4 specific
@@ -82,6 +88,11 @@ class TG4StepManager
     TG4StepStatus GetStepStatus() const;                  // G4 specific
     TG4Limits*    GetLimitsModifiedOnFly() const;         // G4 specific
     Bool_t   IsCollectTracks() const;
+    static G4int GetStepRecordNofLevels();                // G4 specific
+
+        // step record
+    void FillStepRecord(TG4StepRecord& record) const;     // G4 specific
+    const TG4StepRecord& GetStepRecord();                 // G4 specific
         
         // tracking volume(s) 
     G4VPhysicalVolume* GetCurrentPhysicalVolume() const;  // G4 specific
@@ -91,6 +102,7 @@ class TG4StepManager
     const char* CurrentVolName() const;
     const char* CurrentVolOffName(Int_t off) const;
     const char* CurrentVolPath();
+    ULong64_t   CurrentVolPathHash();                     // G4 specific
     Bool_t CurrentBoundaryNormal(
                     Double_t &x, Double_t &y, Double_t &z) const;
     Int_t  CurrentMaterial(Float_t &a, Float_t &z, Float_t &dens, 
@@ -100,6 +112,15 @@ class TG4StepManager
     void Gmtod(Float_t* xm, Float_t* xd, Int_t iflag);
     void Gdtom(Double_t* xd, Double_t* xm, Int_t iflag);
     void Gdtom(Float_t* xd, Float_t* xm, Int_t iflag);
+    G4AffineTransform GetCurrentTransform() const;        // G4 specific
+    void Gmtod(Int_t n, const Double_t* xm, Double_t* xd, // G4 specific
+               Int_t iflag) const;
+    void Gdtom(Int_t n, const Double_t* xd, Double_t* xm, // G4 specific
+               Int_t iflag) const;
+    static void Gmtod(const G4AffineTransform& transform, // G4 specific
+               Int_t n, const Double_t* xm, Double_t* xd, Int_t iflag);
+    static void Gdtom(const G4AffineTransform& transform, // G4 specific
+               Int_t n, const Double_t* xd, Double_t* xm, Int_t iflag);
     Double_t MaxStep() const;
     Int_t GetMaxNStep() const;
 
@@ -157,10 +178,18 @@ class TG4StepManager
     const G4VTouchable* GetCurrentTouchable() const; 
     G4VPhysicalVolume*  GetCurrentOffPhysicalVolume(
                            G4int off, G4bool warn = false) const;
+    void UpdateVolPathCache();
+    static G4bool CheckTransformFlag(Int_t iflag, const G4String& method);
+    static void TransformPoints(const G4AffineTransform& transform, 
+                           Int_t n, const Double_t* in, Double_t* out,
+                           Int_t iflag);
 
     // static data members
     static G4ThreadLocal TG4StepManager*  fgInstance;   ///< this instance
 
+    /// number of volume levels filled in the step record
+    static G4int  fgStepRecordNofLevels;
+
     //
     // data members
     
@@ -195,6 +224,33 @@ class TG4StepManager
 
     /// Cached pointer to thread-local track manager
     TG4TrackManager*    fTrackManager;
+
+    /// Cached pointer to SD services
+    TG4SDServices*      fSDServices;
+
+    /// the record of the current step properties
+    TG4StepRecord       fStepRecord;
+
+    /// info whether the step record is filled for the current step
+    G4bool              fIsStepRecordFilled;
+
+    /// physical volumes along the cached volume path
+    std::vector<G4VPhysicalVolume*>  fVolPathVolumes;
+
+    /// copy numbers along the cached volume path
+    std::vector<G4int>      fVolPathCopyNos;
+
+    /// hashes of the cached volume path up to each level
+    std::vector<ULong64_t>  fVolPathHashes;
+
+    /// lengths of the volume path string up to each level
+    std::vector<size_t>     fVolPathLengths;
+
+    /// number of levels which are up-to-date in the volume path string
+    G4int               fVolPathNofLevels;
+
+    /// buffer for the current volume path
+    G4String            fVolPath;
 };
 
 // inline methods
@@ -207,17 +263,20 @@ inline TG4StepManager* TG4StepManager::Instance() {
 inline void TG4StepManager::SetStep(G4Step* step, TG4StepStatus status) { 
   /// Set current step and step status. 
   fTrack = step->GetTrack(); fStep = step; fStepStatus = status; fGflashSpot = 0;
+  fIsStepRecordFilled = false;
 }
 
 inline void TG4StepManager::SetStep(G4Track* track, TG4StepStatus status) { 
   /// Set current track and step status. 
   fTrack = track; fStep = 0; fStepStatus = status;  fGflashSpot = 0;
+  fIsStepRecordFilled = false;
 }
 
 inline void TG4StepManager::SetStep(G4GFlashSpot* gflashSpot, TG4StepStatus status) {
   /// Set current track and step status.
   fTrack = const_cast<G4Track*>(gflashSpot->GetOriginatorTrack()->GetPrimaryTrack());
   fStep = 0; fStepStatus = status;  fGflashSpot = gflashSpot;
+  fIsStepRecordFilled = false;
 }
 
 inline void TG4StepManager::SetSteppingManager(G4SteppingManager* manager) { 
@@ -252,6 +311,21 @@ inline TG4Limits* TG4StepManager::GetLimitsModifiedOnFly() const {
   /// Return limits that has been modified on fly
   return fLimitsModifiedOnFly;
 }
+
+inline G4int TG4StepManager::GetStepRecordNofLevels() {
+  /// Return the number of volume levels filled in the step record
+  return fgStepRecordNofLevels;
+}
+
+inline const TG4StepRecord& TG4StepManager::GetStepRecord() {
+  /// Return the record of the current step properties;
+  /// the record is filled on the first access in a step
+  if ( ! fIsStepRecordFilled ) {
+    FillStepRecord(fStepRecord);
+    fIsStepRecordFilled = true;
+  }
+  return fStepRecord;
+}
   
 #endif //TG4_STEP_MANAGER_H
 
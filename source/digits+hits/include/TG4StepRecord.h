@@ -0,0 +1,69 @@
+#ifndef TG4_STEP_RECORD_H
+#define TG4_STEP_RECORD_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4StepRecord.h
+/// \brief Definition of the TG4StepRecord structure
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <Rtypes.h>
+
+/// \ingroup digits_hits
+/// \brief The snapshot of the current step properties
+///
+/// The structure is filled by TG4StepManager::FillStepRecord() with the
+/// same values which are returned by the TVirtualMC step methods
+/// (in the VMC units), so that a sensitive detector can read all step
+/// properties via a single call to TGeant4::GetStepRecord().
+///
+/// The volume IDs and copy numbers are filled for the current volume
+/// (level 0) and fNofLevels-1 mother volumes; their number can be set
+/// via TG4StepManager::SetStepRecordNofLevels().
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+struct TG4StepRecord
+{
+  /// The maximum number of volume levels kept in the record
+  enum { kMaxNofLevels = 16 };
+
+  /// The track status bits
+  enum EStatus {
+    kInside      = 0x01, ///< IsTrackInside()
+    kEntering    = 0x02, ///< IsTrackEntering()
+    kExiting     = 0x04, ///< IsTrackExiting()
+    kOut         = 0x08, ///< IsTrackOut()
+    kDisappeared = 0x10, ///< IsTrackDisappeared()
+    kStop        = 0x20, ///< IsTrackStop()
+    kAlive       = 0x40, ///< IsTrackAlive()
+    kNewTrack    = 0x80  ///< IsNewTrack()
+  };
+
+  /// Return true if all given status bits are set
+  Bool_t HasStatus(Int_t status) const { return ( fStatus & status ) == status; }
+
+  Double_t fPosition[4];   ///< track position (x, y, z, t)
+  Double_t fMomentum[4];   ///< track momentum (px, py, pz, etot)
+  Double_t fEdep;          ///< total energy deposit
+  Double_t fNIELEdep;      ///< non-ionizing energy deposit
+  Double_t fStepLength;    ///< step length
+  Double_t fTrackLength;   ///< track length
+  Double_t fCharge;        ///< particle charge
+  Int_t    fPdg;           ///< particle PDG encoding
+  Int_t    fStatus;        ///< track status bits (see EStatus)
+  Int_t    fNofLevels;     ///< number of filled volume levels
+  Int_t    fVolumeID[kMaxNofLevels]; ///< volume IDs (current, mothers)
+  Int_t    fCopyNo[kMaxNofLevels];   ///< volume copy numbers (current, mothers)
+};
+
+#endif //TG4_STEP_RECORD_H
+
@@ -0,0 +1,69 @@
+#ifndef TG4_V_SCORING_HANDLER_H
+#define TG4_V_SCORING_HANDLER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4VScoringHandler.h
+/// \brief Definition of the TG4VScoringHandler class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <globals.hh>
+
+class TG4ScoringSensitiveDetector;
+
+/// \ingroup digits_hits
+/// \brief The abstract base class for user handlers of the scoring
+/// sensitive detectors
+///
+/// The handler is associated with a volume via 
+/// TG4SDManager::SetScoringHandler(); the volume is then made sensitive 
+/// with TG4ScoringSensitiveDetector which sums the energy deposit 
+/// and the step length per volume ID and copy number without any user 
+/// call per step. The accumulated values are passed to the handler 
+/// only once at the end of event.
+///
+/// The copy numbers in the range 0 - (nofDenseCopies-1) are accumulated 
+/// in a preallocated flat array, the other copy numbers in a hash map.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4VScoringHandler
+{
+  public:
+    TG4VScoringHandler(G4int nofDenseCopies = 0);
+    virtual ~TG4VScoringHandler();
+
+    ///  Method to be overriden by user
+    virtual void EndOfEvent(const TG4ScoringSensitiveDetector& sd) = 0;
+
+    // get methods
+    G4int GetNofDenseCopies() const;
+
+  private:    
+    /// Not implemented
+    TG4VScoringHandler(const TG4VScoringHandler& right);
+    /// Not implemented
+    TG4VScoringHandler& operator=(const TG4VScoringHandler& right);
+
+    // data members
+    /// the number of copies accumulated in the flat array
+    G4int  fNofDenseCopies;
+}; 
+
+// inline methods
+
+inline G4int TG4VScoringHandler::GetNofDenseCopies() const {
+  /// Return the number of copies accumulated in the flat array
+  return fNofDenseCopies;
+}
+
+#endif //TG4_V_SCORING_HANDLER_H
+
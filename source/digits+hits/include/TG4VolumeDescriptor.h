@@ -0,0 +1,94 @@
+#ifndef TG4_VOLUME_DESCRIPTOR_H
+#define TG4_VOLUME_DESCRIPTOR_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4VolumeDescriptor.h
+/// \brief Definition of the TG4VolumeDescriptor class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include <globals.hh>
+
+/// \ingroup digits_hits
+/// \brief The volume and material properties of a logical volume
+/// pre-computed for the step level queries.
+///
+/// The descriptors are kept in TG4SDServices in a vector indexed by
+/// G4LogicalVolume::GetInstanceID(); the values are stored already
+/// converted in G3 units.
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+class TG4VolumeDescriptor
+{
+  public:
+             /// Default constructor
+    TG4VolumeDescriptor()
+      : fUserVolumeName(), fVolumeID(0), fMediumID(0), fNofElements(0),
+        fEffA(0.), fEffZ(0.), fDensity(0.), fRadLength(0.), fIsValid(false) {}
+
+             /// Standard constructor
+    TG4VolumeDescriptor(const G4String& userVolumeName,
+                        G4int volumeID, G4int mediumID, G4int nofElements,
+                        G4double effA, G4double effZ,
+                        G4double density, G4double radLength)
+      : fUserVolumeName(userVolumeName), fVolumeID(volumeID),
+        fMediumID(mediumID), fNofElements(nofElements),
+        fEffA(effA), fEffZ(effZ), fDensity(density), fRadLength(radLength),
+        fIsValid(true) {}
+
+             /// Destructor
+    ~TG4VolumeDescriptor() {}
+
+    // methods
+
+             /// Return the user volume name
+    const G4String& GetUserVolumeName() const { return fUserVolumeName; }
+
+             /// Return the VMC volume ID
+    G4int    GetVolumeID() const { return fVolumeID; }
+
+             /// Return the medium ID
+    G4int    GetMediumID() const { return fMediumID; }
+
+             /// Return the number of elements in the volume material
+    G4int    GetNofElements() const { return fNofElements; }
+
+             /// Return the effective A of the volume material (in G3 units)
+    G4double GetEffA() const { return fEffA; }
+
+             /// Return the effective Z of the volume material
+    G4double GetEffZ() const { return fEffZ; }
+
+             /// Return the material density (in G3 units)
+    G4double GetDensity() const { return fDensity; }
+
+             /// Return the material radiation length (in G3 units)
+    G4double GetRadLength() const { return fRadLength; }
+
+             /// Return true if the descriptor was filled
+    G4bool   IsValid() const { return fIsValid; }
+
+  private:
+    // data members
+    G4String fUserVolumeName; ///< user volume name
+    G4int    fVolumeID;       ///< VMC volume ID
+    G4int    fMediumID;       ///< medium ID
+    G4int    fNofElements;    ///< number of elements in material
+    G4double fEffA;           ///< effective A
+    G4double fEffZ;           ///< effective Z
+    G4double fDensity;        ///< density
+    G4double fRadLength;      ///< radiation length
+    G4bool   fIsValid;        ///< info whether the descriptor was filled
+};
+
+#endif //TG4_VOLUME_DESCRIPTOR_H
+
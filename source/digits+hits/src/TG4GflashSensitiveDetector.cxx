@@ -14,6 +14,7 @@
 
 #include "TG4GflashSensitiveDetector.h"
 #include "TG4StepManager.h"
+#include "TG4CallbackTimer.h"
 
 #include <TVirtualMCApplication.h>
 
@@ -41,7 +42,12 @@ G4bool TG4GflashSensitiveDetector::ProcessHits(G4GFlashSpot* gflashSpot, G4Touch
 
   // let user sensitive detector process Gflash step
   fStepManager->SetStep(gflashSpot, kGflashSpot);
-  fMCApplication->Stepping();
+  {
+#ifdef USE_CALLBACK_TIMING
+    TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kStepping);
+#endif
+    fMCApplication->Stepping();
+  }
 
   return true;
 }
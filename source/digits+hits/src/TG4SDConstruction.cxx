@@ -16,6 +16,8 @@
 #include "TG4SDServices.h"
 #include "TG4SensitiveDetector.h"
 #include "TG4GflashSensitiveDetector.h"
+#include "TG4ScoringSensitiveDetector.h"
+#include "TG4SDFilter.h"
 #include "TG4GeometryServices.h"
 #include "TG4StateManager.h"
 
@@ -41,7 +43,8 @@ TG4SDConstruction::TG4SDConstruction()
     fSelectionFromTGeo(false),
     fSVLabel(fgkDefaultSVLabel), 
     fSelection(),
-    fIsGflash(false)
+    fIsGflash(false),
+    fFilters()
 {
 /// Default constructor
 }
@@ -50,6 +53,9 @@ TG4SDConstruction::TG4SDConstruction()
 TG4SDConstruction::~TG4SDConstruction()
 {
 /// Destructor
+
+  std::map<G4String, TG4SDFilter*>::iterator it;
+  for ( it = fFilters.begin(); it != fFilters.end(); ++it ) delete it->second;
 }
 
 //
@@ -58,9 +64,12 @@ TG4SDConstruction::~TG4SDConstruction()
 
 //_____________________________________________________________________________
 void TG4SDConstruction::CreateSD(G4LogicalVolume* lv,
-                                 TVirtualMCSensitiveDetector* userSD) const
+                                 TVirtualMCSensitiveDetector* userSD,
+                                 TG4VScoringHandler* scoringHandler) const
 { 
 /// Create/retrieve a sensitive detector for the given logical volume.
+/// If the scoring handler is given, the scoring sensitive detector
+/// is created.
 
   TG4GeometryServices* geometryServices = TG4GeometryServices::Instance();
   G4SDManager* pSDManager = G4SDManager::GetSDMpointer();
@@ -83,13 +92,16 @@ void TG4SDConstruction::CreateSD(G4LogicalVolume* lv,
     G4int mediumId = TG4GeometryServices::Instance()->GetMediumId(lv);
 
     TG4SensitiveDetector* newSD = 0;
-    if ( fIsGflash ) {
+    if ( scoringHandler ) {
+      newSD = new TG4ScoringSensitiveDetector(sdName, mediumId, scoringHandler);
+    } else if ( fIsGflash ) {
       newSD = new TG4GflashSensitiveDetector(sdName, mediumId);
     } else if ( userSD ) {
       newSD = new TG4SensitiveDetector(userSD, mediumId, fExclusiveSDScoring);
     } else  {
       newSD = new TG4SensitiveDetector(sdName, mediumId);
     }
+    newSD->SetStepFilter(GetFilter(lv->GetName()));
     pSDManager->AddNewDetector(newSD);
 
     if (VerboseLevel() > 1) {
@@ -227,6 +239,10 @@ void TG4SDConstruction::Construct()
     TVirtualMCSensitiveDetector* userSD
       = TG4SDServices::Instance()->GetUserSD(lv->GetName(), false);
 
+    // Check if a user scoring handler is defined
+    TG4VScoringHandler* scoringHandler
+      = TG4SDServices::Instance()->GetScoringHandler(lv->GetName());
+
     // Create SD calling user sensitive detector
 
     if ( userSD ) {
@@ -234,6 +250,10 @@ void TG4SDConstruction::Construct()
       // if ( isMaster ) TG4SDServices::Instance()->MapVolume(lv, sdID);
       isUserSD = true;
     }
+    else if ( scoringHandler ) {
+      // Create SD accumulating edep and step length without user calls
+      CreateSD(lv, 0, scoringHandler);
+    }
     else {
       // Create SD calling MCApplication::Stepping
       // if exclusive scoring via user sensitive detectors is not activated and
@@ -300,3 +320,48 @@ void TG4SDConstruction::AddSelection(const G4String& selection)
     fSelection.insert(token);
   }  
 }  
+
+//_____________________________________________________________________________
+TG4SDFilter* TG4SDConstruction::GetOrCreateFilter(const G4String& volumeName)
+{
+/// Return the step filter for the volume with the given name;
+/// create it if it does not yet exist.
+/// The filters have to be defined before the sensitive detectors 
+/// are constructed.
+
+  TG4SDFilter* filter = GetFilter(volumeName);
+  if ( ! filter ) {
+    filter = new TG4SDFilter();
+    fFilters[volumeName] = filter;
+  }
+  return filter;
+}
+
+//_____________________________________________________________________________
+TG4SDFilter* TG4SDConstruction::GetFilter(const G4String& volumeName) const
+{
+/// Return the step filter for the volume with the given name
+/// or 0 if no filter is defined
+
+  std::map<G4String, TG4SDFilter*>::const_iterator it 
+    = fFilters.find(volumeName);
+  if ( it == fFilters.end() ) return 0;
+
+  return it->second;
+}
+
+//_____________________________________________________________________________
+void TG4SDConstruction::PrintFilters() const
+{
+/// Print all defined step filters
+
+  if ( ! fFilters.size() ) {
+    G4cout << "No SD filters are defined." << G4endl;
+    return;
+  }
+
+  std::map<G4String, TG4SDFilter*>::const_iterator it;
+  for ( it = fFilters.begin(); it != fFilters.end(); ++it ) {
+    it->second->Print(it->first);
+  }
+}
@@ -0,0 +1,102 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4SDFilter.cxx
+/// \brief Implementation of the TG4SDFilter class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TG4SDFilter.h"
+#include "TG4ParticlesManager.h"
+#include "TG4G3Units.h"
+
+#include <G4Track.hh>
+#include <G4ParticleDefinition.hh>
+
+#include <limits>
+
+//_____________________________________________________________________________
+TG4SDFilter::TG4SDFilter()
+  : fMinEdep(0.),
+    fChargedOnly(false),
+    fMinEkin(0.),
+    fMaxEkin(std::numeric_limits<G4double>::max()),
+    fIncludedPdgs(),
+    fExcludedPdgs()
+{
+/// Default constructor
+}
+
+//_____________________________________________________________________________
+TG4SDFilter::~TG4SDFilter()
+{
+/// Destructor
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+G4bool TG4SDFilter::Accept(const G4Track* track, G4double ekin,
+                           G4double edep) const
+{
+/// Return true if the step of the given track with the given kinetic energy
+/// and energy deposit (in Geant4 units) passes all filter criteria.
+/// The kinetic energy and the energy deposit are passed from the caller,
+/// as they are not given in the same way for all kinds of steps
+/// (see the class description).
+/// The cheapest criteria are evaluated first.
+
+  if ( edep < fMinEdep ) return false;
+
+  G4ParticleDefinition* particle = track->GetDefinition();
+
+  if ( fChargedOnly && particle->GetPDGCharge() == 0. ) return false;
+
+  if ( ekin < fMinEkin || ekin > fMaxEkin ) return false;
+
+  if ( fIncludedPdgs.size() || fExcludedPdgs.size() ) {
+    G4int pdg = TG4ParticlesManager::Instance()->GetPDGEncoding(particle);
+    if ( fIncludedPdgs.size() && 
+         fIncludedPdgs.find(pdg) == fIncludedPdgs.end() ) return false;
+    if ( fExcludedPdgs.find(pdg) != fExcludedPdgs.end() ) return false;
+  }
+
+  return true;
+}
+
+//_____________________________________________________________________________
+void TG4SDFilter::Print(const G4String& volumeName) const
+{
+/// Print the filter criteria (in G3 units)
+
+  G4cout << "SD filter for volume " << volumeName << ": " << G4endl
+         << "  minEdep = " << fMinEdep/TG4G3Units::Energy() << " GeV"
+         << "  chargedOnly = " << fChargedOnly 
+         << "  Ekin range = (" << fMinEkin/TG4G3Units::Energy() << ", ";
+  if ( fMaxEkin < std::numeric_limits<G4double>::max() )
+    G4cout << fMaxEkin/TG4G3Units::Energy();
+  else
+    G4cout << "inf";
+  G4cout << ") GeV" << G4endl;
+
+  if ( fIncludedPdgs.size() ) {
+    G4cout << "  included PDGs: ";
+    for ( std::set<G4int>::const_iterator it = fIncludedPdgs.begin();
+          it != fIncludedPdgs.end(); ++it ) G4cout << *it << " ";
+    G4cout << G4endl;
+  }
+  if ( fExcludedPdgs.size() ) {
+    G4cout << "  excluded PDGs: ";
+    for ( std::set<G4int>::const_iterator it = fExcludedPdgs.begin();
+          it != fExcludedPdgs.end(); ++it ) G4cout << *it << " ";
+    G4cout << G4endl;
+  }
+}
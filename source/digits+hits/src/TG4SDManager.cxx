@@ -145,6 +145,18 @@ void TG4SDManager::SetSensitiveDetector(const TString& volName,
   fSDServices->MapUserSD(volName.Data(), sd);
 }
 
+//_____________________________________________________________________________
+void TG4SDManager::SetScoringHandler(const TString& volName,
+                                     TG4VScoringHandler* handler)
+{
+/// Set user scoring handler to (a) volume(s) with the given name;
+/// the volume(s) will be made sensitive with TG4ScoringSensitiveDetector.
+/// As user sensitive detectors, the handlers have to be set 
+/// on each thread in TVirtualMCApplication::ConstructSensitiveDetectors().
+
+  fSDServices->MapScoringHandler(volName.Data(), handler);
+}
+
 //_____________________________________________________________________________
 TVirtualMCSensitiveDetector* TG4SDManager::GetSensitiveDetector(
                                              const TString& volName) const
@@ -15,11 +15,18 @@
 #include "TG4SDMessenger.h"
 #include "TG4SDConstruction.h"
 #include "TG4SDServices.h"
+#include "TG4SDFilter.h"
+#include "TG4G3Units.h"
 
 #include <G4UIdirectory.hh>
 #include <G4UIcmdWithAString.hh>
 #include <G4UIcmdWithABool.hh>
 #include <G4UIcmdWithoutParameter.hh>
+#include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
+#include <G4AnalysisUtilities.hh>
+
+#include <limits>
 
 //______________________________________________________________________________
 TG4SDMessenger::TG4SDMessenger(TG4SDConstruction* sdConstruction)
@@ -30,7 +37,13 @@ TG4SDMessenger::TG4SDMessenger(TG4SDConstruction* sdConstruction)
     fSetSVLabelCmd(0),
     fSetGflashCmd(0),
     fSetExclusiveSDScoringCmd(0),
-    fPrintUserSDsCmd(0)
+    fPrintUserSDsCmd(0),
+    fSetSDFilterMinEdepCmd(0),
+    fSetSDFilterChargedOnlyCmd(0),
+    fSetSDFilterEkinRangeCmd(0),
+    fAddSDFilterPdgCmd(0),
+    fAddSDFilterExcludedPdgCmd(0),
+    fPrintSDFiltersCmd(0)
 { 
 /// Standard constructor
 
@@ -87,6 +100,8 @@ TG4SDMessenger::TG4SDMessenger(TG4SDConstruction* sdConstruction)
     = new G4UIcmdWithoutParameter("/mcDet/printUserSDs", this);
   fPrintUserSDsCmd->SetGuidance("Prints user sensitive detectors.");
   fPrintUserSDsCmd->AvailableForStates(G4State_Init, G4State_Idle);
+
+  CreateSDFilterCmds();
 }
 
 //______________________________________________________________________________
@@ -100,6 +115,103 @@ TG4SDMessenger::~TG4SDMessenger()
   delete fSetGflashCmd;
   delete fSetExclusiveSDScoringCmd;
   delete fPrintUserSDsCmd;
+  delete fSetSDFilterMinEdepCmd;
+  delete fSetSDFilterChargedOnlyCmd;
+  delete fSetSDFilterEkinRangeCmd;
+  delete fAddSDFilterPdgCmd;
+  delete fAddSDFilterExcludedPdgCmd;
+  delete fPrintSDFiltersCmd;
+}
+
+//
+// private methods
+//
+
+//______________________________________________________________________________
+void TG4SDMessenger::CreateSDFilterCmds()
+{
+/// Create commands for the step filters
+
+  G4UIparameter* volumeName = new G4UIparameter("volumeName", 's', false);
+  volumeName->SetGuidance("Sensitive volume name.");
+  G4UIparameter* minEdep = new G4UIparameter("minEdep", 'd', false);
+  minEdep->SetGuidance("The minimum energy deposit (GeV).");
+
+  fSetSDFilterMinEdepCmd 
+    = new G4UIcommand("/mcDet/setSDFilterMinEdep", this);
+  fSetSDFilterMinEdepCmd->SetGuidance(
+    "Set the minimum energy deposit of steps passed to the user code.");
+  fSetSDFilterMinEdepCmd->SetGuidance(
+    "The track start and boundary steps, with zero energy deposit,");
+  fSetSDFilterMinEdepCmd->SetGuidance(
+    "are then not passed either.");
+  fSetSDFilterMinEdepCmd->SetParameter(volumeName);
+  fSetSDFilterMinEdepCmd->SetParameter(minEdep);
+  fSetSDFilterMinEdepCmd->AvailableForStates(G4State_PreInit);
+
+  volumeName = new G4UIparameter("volumeName", 's', false);
+  volumeName->SetGuidance("Sensitive volume name.");
+  G4UIparameter* chargedOnly = new G4UIparameter("chargedOnly", 'b', false);
+  chargedOnly->SetGuidance("Option to accept only charged particles.");
+
+  fSetSDFilterChargedOnlyCmd 
+    = new G4UIcommand("/mcDet/setSDFilterChargedOnly", this);
+  fSetSDFilterChargedOnlyCmd->SetGuidance(
+    "Pass only steps of charged particles to the user code.");
+  fSetSDFilterChargedOnlyCmd->SetParameter(volumeName);
+  fSetSDFilterChargedOnlyCmd->SetParameter(chargedOnly);
+  fSetSDFilterChargedOnlyCmd->AvailableForStates(G4State_PreInit);
+
+  volumeName = new G4UIparameter("volumeName", 's', false);
+  volumeName->SetGuidance("Sensitive volume name.");
+  G4UIparameter* minEkin = new G4UIparameter("minEkin", 'd', false);
+  minEkin->SetGuidance("The minimum kinetic energy (GeV).");
+  G4UIparameter* maxEkin = new G4UIparameter("maxEkin", 'd', true);
+  maxEkin->SetGuidance("The maximum kinetic energy (GeV); no limit if not set.");
+  maxEkin->SetDefaultValue(-1.);
+
+  fSetSDFilterEkinRangeCmd 
+    = new G4UIcommand("/mcDet/setSDFilterEkinRange", this);
+  fSetSDFilterEkinRangeCmd->SetGuidance(
+    "Pass only steps with the kinetic energy at the step start\n");
+  fSetSDFilterEkinRangeCmd->SetGuidance(
+    "in the given window to the user code.");
+  fSetSDFilterEkinRangeCmd->SetParameter(volumeName);
+  fSetSDFilterEkinRangeCmd->SetParameter(minEkin);
+  fSetSDFilterEkinRangeCmd->SetParameter(maxEkin);
+  fSetSDFilterEkinRangeCmd->AvailableForStates(G4State_PreInit);
+
+  volumeName = new G4UIparameter("volumeName", 's', false);
+  volumeName->SetGuidance("Sensitive volume name.");
+  G4UIparameter* pdgs = new G4UIparameter("pdgs", 's', false);
+  pdgs->SetGuidance("The list of PDG codes.");
+
+  fAddSDFilterPdgCmd 
+    = new G4UIcommand("/mcDet/addSDFilterPdg", this);
+  fAddSDFilterPdgCmd->SetGuidance(
+    "Pass only steps of particles with given PDG codes to the user code.");
+  fAddSDFilterPdgCmd->SetParameter(volumeName);
+  fAddSDFilterPdgCmd->SetParameter(pdgs);
+  fAddSDFilterPdgCmd->AvailableForStates(G4State_PreInit);
+
+  volumeName = new G4UIparameter("volumeName", 's', false);
+  volumeName->SetGuidance("Sensitive volume name.");
+  pdgs = new G4UIparameter("pdgs", 's', false);
+  pdgs->SetGuidance("The list of PDG codes.");
+
+  fAddSDFilterExcludedPdgCmd 
+    = new G4UIcommand("/mcDet/addSDFilterExcludedPdg", this);
+  fAddSDFilterExcludedPdgCmd->SetGuidance(
+    "Do not pass steps of particles with given PDG codes to the user code.");
+  fAddSDFilterExcludedPdgCmd->SetParameter(volumeName);
+  fAddSDFilterExcludedPdgCmd->SetParameter(pdgs);
+  fAddSDFilterExcludedPdgCmd->AvailableForStates(G4State_PreInit);
+
+  fPrintSDFiltersCmd
+    = new G4UIcmdWithoutParameter("/mcDet/printSDFilters", this);
+  fPrintSDFiltersCmd->SetGuidance("Prints the SD step filters.");
+  fPrintSDFiltersCmd->AvailableForStates(
+    G4State_PreInit, G4State_Init, G4State_Idle);
 }
 
 //
@@ -133,4 +245,56 @@ void TG4SDMessenger::SetNewValue(G4UIcommand* command,
   else if ( command == fPrintUserSDsCmd ) {
     TG4SDServices::Instance()->PrintUserSensitiveDetectors();
   }
+  else if ( command == fPrintSDFiltersCmd ) {
+    fSDConstruction->PrintFilters();
+  }
+  else if ( command == fSetSDFilterMinEdepCmd ||
+            command == fSetSDFilterChargedOnlyCmd ||
+            command == fSetSDFilterEkinRangeCmd ||
+            command == fAddSDFilterPdgCmd ||
+            command == fAddSDFilterExcludedPdgCmd ) {
+
+    // tokenize parameters in a vector
+    std::vector<G4String> parameters;
+    G4Analysis::Tokenize(newValue, parameters);
+
+    G4int counter = 0;
+    G4String volumeName = parameters[counter++];
+    TG4SDFilter* filter = fSDConstruction->GetOrCreateFilter(volumeName);
+
+    if ( command == fSetSDFilterMinEdepCmd ) {
+      // apply units
+      filter->SetMinEdep(
+        G4UIcommand::ConvertToDouble(parameters[counter++])
+        * TG4G3Units::Energy());
+    }
+    else if ( command == fSetSDFilterChargedOnlyCmd ) {
+      filter->SetChargedOnly(
+        G4UIcommand::ConvertToBool(parameters[counter++]));
+    }
+    else if ( command == fSetSDFilterEkinRangeCmd ) {
+      G4double minEkin = G4UIcommand::ConvertToDouble(parameters[counter++]);
+      G4double maxEkin = -1.;
+      if ( G4int(parameters.size()) > counter ) {
+        maxEkin = G4UIcommand::ConvertToDouble(parameters[counter++]);
+      }
+      // apply units
+      minEkin *= TG4G3Units::Energy();
+      if ( maxEkin < 0. ) 
+        maxEkin = std::numeric_limits<G4double>::max();
+      else
+        maxEkin *= TG4G3Units::Energy();
+      filter->SetEkinRange(minEkin, maxEkin);
+    }
+    else {
+      // the rest of parameters are PDG codes
+      while ( counter < G4int(parameters.size()) ) {
+        G4int pdg = G4UIcommand::ConvertToInt(parameters[counter++]);
+        if ( command == fAddSDFilterPdgCmd ) 
+          filter->AddIncludedPdg(pdg);
+        else
+          filter->AddExcludedPdg(pdg);
+      }
+    }
+  }
 }
@@ -15,6 +15,7 @@
 #include "TG4SDServices.h"
 #include "TG4SensitiveDetector.h"
 #include "TG4GeometryServices.h"
+#include "TG4G3Units.h"
 #include "TG4Globals.h"
 
 #include <G4VSensitiveDetector.hh>
@@ -31,6 +32,7 @@ const G4int TG4SDServices::fgkFirstVolumeId = 1;
 
 G4ThreadLocal std::set<TVirtualMCSensitiveDetector*>*  TG4SDServices::fgUserSDs = 0;
 G4ThreadLocal std::map<G4String, TVirtualMCSensitiveDetector*>*  TG4SDServices::fgUserSDMap = 0;
+G4ThreadLocal std::map<G4String, TG4VScoringHandler*>*  TG4SDServices::fgScoringHandlerMap = 0;
 
 //_____________________________________________________________________________
 TG4SDServices::TG4SDServices()
@@ -38,7 +40,8 @@ TG4SDServices::TG4SDServices()
     fVolNameToIdMap(),
     fVolIdToLVMap(),
     fLVToVolIdMap(),
-    fIsUserSDs(false)
+    fIsUserSDs(false),
+    fVolumeDescriptors()
 {
 /// Default constructor
 
@@ -116,6 +119,75 @@ void TG4SDServices::MapUserSD(const G4String& volumeName,
   }
 }
 
+//_____________________________________________________________________________
+void TG4SDServices::MapScoringHandler(const G4String& volumeName,
+                                      TG4VScoringHandler* handler)
+{
+/// Add the given user scoring handler in the map.
+/// Print a warning if a given volume name is already present
+
+  // Create the map if it does not yet exist
+  if ( ! fgScoringHandlerMap ) {
+    fgScoringHandlerMap = new std::map<G4String, TG4VScoringHandler*>();
+  }
+
+  if ( fgScoringHandlerMap->find(volumeName) == fgScoringHandlerMap->end() ) {
+    (*fgScoringHandlerMap)[volumeName] = handler;
+  } else {
+    TG4Globals::Warning(
+      "TG4SDServices", "MapScoringHandler",
+      TString( "A scoring handler for volume ") + TString(volumeName.data())
+      + TString(" has been already defined.") + TG4Globals::Endl()
+      + TString("Setting was ingored."));
+  }
+}
+
+//_____________________________________________________________________________
+void TG4SDServices::MapVolumeDescriptors()
+{
+/// Fill the volume descriptors for all logical volumes in the store.
+/// The descriptors have to be filled after the volume IDs and the medium map
+/// are defined; they are then used by TG4StepManager to answer the
+/// current volume and material queries without any map lookup.
+
+  TG4GeometryServices* geometryServices = TG4GeometryServices::Instance();
+  G4LogicalVolumeStore* lvStore = G4LogicalVolumeStore::GetInstance();
+
+  // Get the size of the vector from the maximum instance ID
+  size_t size = 0;
+  for ( G4int i=0; i<G4int(lvStore->size()); i++ ) {
+    size_t index = (*lvStore)[i]->GetInstanceID();
+    if ( index + 1 > size ) size = index + 1;
+  }
+
+  fVolumeDescriptors.clear();
+  fVolumeDescriptors.resize(size);
+
+  for ( G4int i=0; i<G4int(lvStore->size()); i++ ) {
+    G4LogicalVolume* lv = (*lvStore)[i];
+    G4Material* material = lv->GetMaterial();
+
+    G4int nofElements = 0;
+    G4double effA = 0.;
+    G4double effZ = 0.;
+    G4double density = 0.;
+    G4double radLength = 0.;
+    if ( material ) {
+      nofElements = material->GetNumberOfElements();
+      effA = geometryServices->GetEffA(material);
+      effZ = geometryServices->GetEffZ(material);
+      density = material->GetDensity()/TG4G3Units::MassDensity();
+      radLength = material->GetRadlen()/TG4G3Units::Length();
+    }
+
+    fVolumeDescriptors[lv->GetInstanceID()]
+      = TG4VolumeDescriptor(
+          geometryServices->UserVolumeName(lv->GetName()),
+          GetVolumeID(lv), GetMediumID(lv), nofElements,
+          effA, effZ, density, radLength);
+  }
+}
+
 //_____________________________________________________________________________
 void TG4SDServices::PrintStatistics(G4bool open, G4bool close) const
 {
@@ -335,6 +407,23 @@ TVirtualMCSensitiveDetector* TG4SDServices::GetUserSD(G4String volumeName,
   return it->second;
 }
 
+//_____________________________________________________________________________
+TG4VScoringHandler* TG4SDServices::GetScoringHandler(
+                                     const G4String& volumeName) const
+{
+/// Return the user scoring handler for the volume with the given name
+/// or 0 if no handler is defined
+
+  if ( ! fgScoringHandlerMap ) return 0;
+
+  std::map<G4String, TG4VScoringHandler*>::const_iterator it
+    = fgScoringHandlerMap->find(volumeName);
+
+  if ( it == fgScoringHandlerMap->end() ) return 0;
+
+  return it->second;
+}
+
 //_____________________________________________________________________________
 G4String TG4SDServices::GetVolumeName(G4int volumeId) const
 {
@@ -0,0 +1,189 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4ScoringSensitiveDetector.cxx
+/// \brief Implementation of the TG4ScoringSensitiveDetector class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4ScoringSensitiveDetector.h"
+#include "TG4VScoringHandler.h"
+#include "TG4StepManager.h"
+#include "TG4SDFilter.h"
+#include "TG4G3Units.h"
+
+//_____________________________________________________________________________
+TG4ScoringSensitiveDetector::TG4ScoringSensitiveDetector(
+                                   G4String sdName, G4int mediumID,
+                                   TG4VScoringHandler* handler)
+  : TG4SensitiveDetector(sdName, mediumID),
+    fHandler(handler),
+    fNofDenseCopies(handler->GetNofDenseCopies()),
+    fDenseVolumeIDs(),
+    fDenseCells(),
+    fSparseCells(),
+    fCellDenseIndices(),
+    fVolumeIDs(),
+    fCopyNos(),
+    fEdeps(),
+    fStepLengths()
+{
+/// Standard constructor with the specified \em name and the user 
+/// scoring handler
+
+  if ( fNofDenseCopies < 0 ) fNofDenseCopies = 0;
+}
+
+//_____________________________________________________________________________
+TG4ScoringSensitiveDetector::~TG4ScoringSensitiveDetector() 
+{
+/// Destructor
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4int TG4ScoringSensitiveDetector::AddCell(G4int volumeID, G4int copyNo,
+                                           G4int denseIndex)
+{
+/// Add a new cell with zero values and return its index
+
+  fCellDenseIndices.push_back(denseIndex);
+  fVolumeIDs.push_back(volumeID);
+  fCopyNos.push_back(copyNo);
+  fEdeps.push_back(0.);
+  fStepLengths.push_back(0.);
+
+  return fVolumeIDs.size() - 1;
+}
+
+//_____________________________________________________________________________
+G4int TG4ScoringSensitiveDetector::GetCell(G4int volumeID, G4int copyNo)
+{
+/// Return the index of the cell for the given volume ID and copy number;
+/// create the cell if it does not yet exist
+
+  if ( copyNo >= 0 && copyNo < fNofDenseCopies ) {
+    // find the volume slot in the flat array
+    // (there is typically only one or a few volumes per sensitive detector)
+    G4int slot = 0;
+    G4int nofSlots = fDenseVolumeIDs.size();
+    while ( slot < nofSlots && fDenseVolumeIDs[slot] != volumeID ) ++slot;
+    if ( slot == nofSlots ) {
+      fDenseVolumeIDs.push_back(volumeID);
+      fDenseCells.resize(fDenseCells.size() + fNofDenseCopies, -1);
+    }
+
+    G4int denseIndex = slot*fNofDenseCopies + copyNo;
+    if ( fDenseCells[denseIndex] < 0 ) {
+      fDenseCells[denseIndex] = AddCell(volumeID, copyNo, denseIndex);
+    }
+    return fDenseCells[denseIndex];
+  }
+
+  G4long key 
+    = ( static_cast<G4long>(volumeID) << 32 ) | 
+      ( static_cast<G4long>(copyNo) & 0xffffffffL );
+  std::unordered_map<G4long, G4int>::const_iterator it = fSparseCells.find(key);
+  if ( it != fSparseCells.end() ) return it->second;
+
+  G4int cell = AddCell(volumeID, copyNo, -1);
+  fSparseCells[key] = cell;
+  return cell;
+}
+
+//_____________________________________________________________________________
+void TG4ScoringSensitiveDetector::Reset()
+{
+/// Reset the accumulated values; 
+/// only the used entries of the flat array are reset
+
+  for ( G4int i=0; i<G4int(fCellDenseIndices.size()); ++i ) {
+    if ( fCellDenseIndices[i] >= 0 ) fDenseCells[fCellDenseIndices[i]] = -1;
+  }
+  fSparseCells.clear();
+
+  fCellDenseIndices.clear();
+  fVolumeIDs.clear();
+  fCopyNos.clear();
+  fEdeps.clear();
+  fStepLengths.clear();
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+G4bool TG4ScoringSensitiveDetector::ProcessHits(G4Step* step, 
+                                                G4TouchableHistory*)
+{
+/// Add the step energy deposit and the step length to the cell
+/// of the current volume ID and copy number.
+
+  // apply the step filter
+  if ( fStepFilter && 
+       ! fStepFilter->Accept(step->GetTrack(),
+                             step->GetPreStepPoint()->GetKineticEnergy(),
+                             step->GetTotalEnergyDeposit()) ) return false;
+
+  fStepManager->SetStep(step, kNormalStep);
+
+  Int_t copyNo;
+  Int_t volumeID = fStepManager->CurrentVolID(copyNo);
+  G4int cell = GetCell(volumeID, copyNo);
+
+  fEdeps[cell] += fStepManager->Edep();
+  fStepLengths[cell] += fStepManager->TrackStep();
+
+  return true;
+}
+
+//_____________________________________________________________________________
+G4bool TG4ScoringSensitiveDetector::ProcessHitsOnBoundary(G4Step* step)
+{
+/// Add the energy deposit on the geometrical boundary (which is non zero
+/// only in case of optical photon detection) to the cell of the volume
+/// which the track is entering.
+
+  fStepManager->SetStep(step, kBoundary);
+
+  Double_t edep = fStepManager->Edep();
+  if ( edep == 0. ) return true;
+
+  // apply the step filter
+  if ( fStepFilter && 
+       ! fStepFilter->Accept(step->GetTrack(),
+                             step->GetPostStepPoint()->GetKineticEnergy(),
+                             edep*TG4G3Units::Energy()) ) return false;
+
+  Int_t copyNo;
+  Int_t volumeID = fStepManager->CurrentVolID(copyNo);
+  fEdeps[GetCell(volumeID, copyNo)] += edep;
+
+  return true;
+}
+
+//_____________________________________________________________________________
+void TG4ScoringSensitiveDetector::ProcessHitsOnTrackStart()
+{
+/// Nothing is scored at the track start.
+}
+
+//_____________________________________________________________________________
+void TG4ScoringSensitiveDetector::EndOfEvent(G4HCofThisEvent* /*hce*/)
+{
+/// Pass the accumulated values to the user handler and reset them.
+
+  if ( fHandler ) fHandler->EndOfEvent(*this);
+
+  Reset();
+}
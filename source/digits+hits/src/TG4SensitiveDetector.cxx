@@ -14,6 +14,10 @@
 
 #include "TG4SensitiveDetector.h"
 #include "TG4StepManager.h"
+#include "TG4SDFilter.h"
+#include "TG4TrackManager.h"
+#include "TG4G3Units.h"
+#include "TG4CallbackTimer.h"
 
 #include <TVirtualMCApplication.h>
 #include <TVirtualMCSensitiveDetector.h>
@@ -24,8 +28,10 @@ G4ThreadLocal G4int TG4SensitiveDetector::fgSDCounter = 0;
 TG4SensitiveDetector::TG4SensitiveDetector(G4String sdName, G4int mediumID)
   : G4VSensitiveDetector(sdName),
     fStepManager(TG4StepManager::Instance()),
+    fTrackManager(TG4TrackManager::Instance()),
     fMCApplication(TVirtualMCApplication::Instance()),
     fUserSD(0),
+    fStepFilter(0),
     fID(++fgSDCounter),
     fMediumID(mediumID)
 {
@@ -38,8 +44,10 @@ TG4SensitiveDetector::TG4SensitiveDetector(
                              G4bool exclusiveSD)
   : G4VSensitiveDetector(userSD->GetName()),
     fStepManager(TG4StepManager::Instance()),
+    fTrackManager(TG4TrackManager::Instance()),
     fMCApplication(0),
     fUserSD(userSD),
+    fStepFilter(0),
     fID(++fgSDCounter),
     fMediumID(mediumID)
 {
@@ -60,16 +68,33 @@ TG4SensitiveDetector::~TG4SensitiveDetector()
 // private methods
 //
 
+//_____________________________________________________________________________
+void TG4SensitiveDetector::SaveDroppedTrack(const G4Track* track)
+{
+/// Save the track in the VMC stack if it was not saved by the track save 
+/// policy and the policy requires saving the tracks with SD hits.
+
+  if ( ! fTrackManager->GetTrackSavePolicy().IsSaveOnSDHit() ) return;
+
+  fTrackManager->SaveDroppedTrack(track);
+}
+
 //_____________________________________________________________________________
 void TG4SensitiveDetector::UserProcessHits()
 {
 /// Call user SD and/or VMC application stepping function.
 
   if ( fUserSD ) {
+#ifdef USE_CALLBACK_TIMING
+    TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kSDProcessHits);
+#endif
     fUserSD->ProcessHits();
   }
 
   if ( fMCApplication ) {
+#ifdef USE_CALLBACK_TIMING
+    TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kStepping);
+#endif
     fMCApplication->Stepping();
   }
 }
@@ -83,6 +108,15 @@ G4bool TG4SensitiveDetector::ProcessHits(G4Step* step, G4TouchableHistory*)
 {
 /// Call user defined sensitive detector.
 
+  // apply the step filter
+  if ( fStepFilter && 
+       ! fStepFilter->Accept(step->GetTrack(),
+                             step->GetPreStepPoint()->GetKineticEnergy(),
+                             step->GetTotalEnergyDeposit()) ) return false;
+
+  // save the track not selected by the track save policy if requested
+  SaveDroppedTrack(step->GetTrack());
+
   // let user sensitive detector process normal step
   fStepManager->SetStep(step, kNormalStep);
   UserProcessHits();
@@ -98,6 +132,17 @@ G4bool TG4SensitiveDetector::ProcessHitsOnBoundary(G4Step* step)
 
   // let user sensitive detector process boundary step
   fStepManager->SetStep(step, kBoundary);
+
+  // apply the step filter
+  if ( fStepFilter && 
+       ! fStepFilter->Accept(step->GetTrack(),
+                             step->GetPostStepPoint()->GetKineticEnergy(),
+                             fStepManager->Edep()*TG4G3Units::Energy()) ) 
+    return false;
+
+  // save the track not selected by the track save policy if requested
+  SaveDroppedTrack(step->GetTrack());
+
   UserProcessHits();
 
   return true;
@@ -108,5 +153,14 @@ void TG4SensitiveDetector::ProcessHitsOnTrackStart()
 {
 /// Call VMC application stepping function.
 
+  // apply the step filter
+  // (there is no energy deposit at the track start)
+  G4Track* track = fStepManager->GetTrack();
+  if ( fStepFilter && 
+       ! fStepFilter->Accept(track, track->GetKineticEnergy(), 0.) ) return;
+
+  // save the track not selected by the track save policy if requested
+  SaveDroppedTrack(track);
+
   UserProcessHits();
 }
@@ -16,6 +16,7 @@
 #include "TG4SteppingAction.h"
 #include "TG4GeometryServices.h"
 #include "TG4SDServices.h"
+#include "TG4VolumeDescriptor.h"
 #include "TG4ParticlesManager.h"
 #include "TG4PhysicsManager.h"
 #include "TG4TrackManager.h"
@@ -40,6 +41,7 @@
 #include <TMath.h>
 
 G4ThreadLocal TG4StepManager* TG4StepManager::fgInstance = 0;
+G4int TG4StepManager::fgStepRecordNofLevels = 1;
 
 //_____________________________________________________________________________
 TG4StepManager::TG4StepManager(const TString& userGeometry) 
@@ -52,7 +54,16 @@ TG4StepManager::TG4StepManager(const TString& userGeometry)
     fNameBuffer(),
     fCopyNoOffset(0),
     fDivisionCopyNoOffset(0),
-    fTrackManager(0)
+    fTrackManager(0),
+    fSDServices(TG4SDServices::Instance()),
+    fStepRecord(),
+    fIsStepRecordFilled(false),
+    fVolPathVolumes(),
+    fVolPathCopyNos(),
+    fVolPathHashes(),
+    fVolPathLengths(),
+    fVolPathNofLevels(0),
+    fVolPath()
 {
 /// Standard constructor
 /// \param userGeometry  User selection of geometry definition and navigation 
@@ -195,6 +206,123 @@ TG4StepManager::GetCurrentOffPhysicalVolume(G4int off, G4bool warn) const
   return touchable->GetVolume(off);
 }     
 
+//_____________________________________________________________________________
+void TG4StepManager::UpdateVolPathCache()
+{
+/// Update the cached volumes, copy numbers and path hashes along
+/// the current navigation history.
+/// Only the levels below the first changed level are recomputed;
+/// the path string levels are invalidated from this level and they
+/// are rebuilt only in CurrentVolPath().
+
+  // FNV-1a 64-bit parameters
+  static const ULong64_t kHashOffset = 14695981039346656037ULL;
+  static const ULong64_t kHashPrime  = 1099511628211ULL;
+
+  // Get current touchable
+  const G4VTouchable* touchable = GetCurrentTouchable();
+  G4int depth = touchable->GetHistoryDepth();
+  G4int nofLevels = depth + 1;
+
+  // find the first level which differs from the cached path
+  G4int nofCached = fVolPathVolumes.size();
+  G4int firstChanged = 0;
+  for ( ; firstChanged<nofLevels; ++firstChanged ) {
+    if ( firstChanged >= nofCached ) break;
+
+    // the current volume is taken as in the other CurrentVol* methods
+    G4VPhysicalVolume* physVolume
+      = ( firstChanged < depth ) 
+          ? touchable->GetHistory()->GetVolume(firstChanged)
+          : GetCurrentPhysicalVolume();
+
+    if ( fVolPathVolumes[firstChanged] != physVolume ||
+         fVolPathCopyNos[firstChanged] != physVolume->GetCopyNo() ) break;
+  }
+
+  // the path string is valid only above the first changed level
+  if ( fVolPathNofLevels > firstChanged ) fVolPathNofLevels = firstChanged;
+
+  if ( firstChanged == nofLevels && nofCached == nofLevels ) return;
+
+  // drop the changed levels and recompute them
+  fVolPathVolumes.resize(firstChanged);
+  fVolPathCopyNos.resize(firstChanged);
+  fVolPathHashes.resize(firstChanged);
+
+  for ( G4int level=firstChanged; level<nofLevels; ++level ) {
+    G4VPhysicalVolume* physVolume
+      = ( level < depth ) ? touchable->GetHistory()->GetVolume(level)
+                          : GetCurrentPhysicalVolume();
+    G4int copyNo = physVolume->GetCopyNo();
+
+    // volume ID
+    G4LogicalVolume* lv = physVolume->GetLogicalVolume();
+    const TG4VolumeDescriptor* descriptor 
+      = fSDServices->GetVolumeDescriptor(lv);
+    G4int volumeID
+      = descriptor ? descriptor->GetVolumeID() : fSDServices->GetVolumeID(lv);
+
+    ULong64_t hash = level ? fVolPathHashes[level-1] : kHashOffset;
+    hash = ( hash ^ static_cast<UInt_t>(volumeID) ) * kHashPrime;
+    hash = ( hash ^ static_cast<UInt_t>(copyNo) ) * kHashPrime;
+
+    fVolPathVolumes.push_back(physVolume);
+    fVolPathCopyNos.push_back(copyNo);
+    fVolPathHashes.push_back(hash);
+  }
+}
+
+//_____________________________________________________________________________
+G4bool TG4StepManager::CheckTransformFlag(Int_t iflag, const G4String& method)
+{
+/// Check if the Gmtod, Gdtom option has an allowed value
+
+  if ( iflag != 1 && iflag != 2 ) {
+      TString text = "iflag=";
+      text += iflag;
+      TG4Globals::Warning(
+        "TG4StepManager", method, text + " is different from 1..2.");
+      return false;
+  }
+
+  return true;
+}
+
+//_____________________________________________________________________________
+void TG4StepManager::TransformPoints(const G4AffineTransform& transform,
+                                     Int_t n, const Double_t* in, Double_t* out,
+                                     Int_t iflag)
+{
+/// Apply the given transformation on n points (iflag = 1) or directions
+/// (iflag = 2) given in G3 units in the array (x0, y0, z0, x1, y1, z1, ...).
+/// The transformation elements are read only once and the unit conversion
+/// is applied on the translation, so that the loop over points does not
+/// include any function call.
+
+  const G4double rxx = transform[0], rxy = transform[1], rxz = transform[2];
+  const G4double ryx = transform[4], ryy = transform[5], ryz = transform[6];
+  const G4double rzx = transform[8], rzy = transform[9], rzz = transform[10];
+
+  G4double tx = 0.;
+  G4double ty = 0.;
+  G4double tz = 0.;
+  if ( iflag == 1 ) {
+    tx = transform[12]/TG4G3Units::Length();
+    ty = transform[13]/TG4G3Units::Length();
+    tz = transform[14]/TG4G3Units::Length();
+  }
+
+  for ( Int_t i=0; i<3*n; i+=3 ) {
+    const G4double x = in[i];
+    const G4double y = in[i+1];
+    const G4double z = in[i+2];
+    out[i]   = x*rxx + y*ryx + z*rzx + tx;
+    out[i+1] = x*rxy + y*ryy + z*rzy + ty;
+    out[i+2] = x*rxz + y*ryz + z*rzz + tz;
+  }
+}
+
 //
 // public methods
 //
@@ -329,6 +457,25 @@ void TG4StepManager::ForceDecayTime(Float_t time)
   particle->SetPDGLifeTime(time*TG4G3Units::Time());
 }
 
+//_____________________________________________________________________________
+void TG4StepManager::SetStepRecordNofLevels(G4int nofLevels)
+{
+/// Set the number of volume levels (the current volume and its mothers)
+/// filled in the step record.
+/// The setting is shared by all threads.
+
+  if ( nofLevels < 1 || nofLevels > TG4StepRecord::kMaxNofLevels ) {
+    TString text = "nofLevels=";
+    text += nofLevels;
+    TG4Globals::Warning(
+      "TG4StepManager", "SetStepRecordNofLevels",
+      text + " is out of the allowed range; setting was ignored.");
+    return;
+  }
+
+  fgStepRecordNofLevels = nofLevels;
+}
+
 //_____________________________________________________________________________
 Bool_t  TG4StepManager::IsCollectTracks() const
 {
@@ -397,7 +544,11 @@ Int_t TG4StepManager::CurrentVolID(Int_t& copyNo) const
        physVolume->IsReplicated() )  copyNo += fDivisionCopyNoOffset;
 
   // sensitive detector ID
-  return TG4SDServices::Instance()->GetVolumeID(physVolume->GetLogicalVolume());
+  const TG4VolumeDescriptor* descriptor
+    = fSDServices->GetVolumeDescriptor(physVolume->GetLogicalVolume());
+  if ( descriptor ) return descriptor->GetVolumeID();
+
+  return fSDServices->GetVolumeID(physVolume->GetLogicalVolume());
 } 
 
 //_____________________________________________________________________________
@@ -420,7 +571,11 @@ Int_t TG4StepManager::CurrentVolOffID(Int_t off, Int_t&  copyNo) const
          mother->IsReplicated() )  copyNo += fDivisionCopyNoOffset;
 
     // sensitive detector ID
-    return TG4SDServices::Instance()->GetVolumeID(mother->GetLogicalVolume());
+    const TG4VolumeDescriptor* descriptor
+      = fSDServices->GetVolumeDescriptor(mother->GetLogicalVolume());
+    if ( descriptor ) return descriptor->GetVolumeID();
+
+    return fSDServices->GetVolumeID(mother->GetLogicalVolume());
   }
   else {
     copyNo = 0;
@@ -433,9 +588,12 @@ const char* TG4StepManager::CurrentVolName() const
 {
 /// Return the current physical volume name.
 
+  G4LogicalVolume* lv = GetCurrentPhysicalVolume()->GetLogicalVolume();
+  const TG4VolumeDescriptor* descriptor = fSDServices->GetVolumeDescriptor(lv);
+  if ( descriptor ) return descriptor->GetUserVolumeName().data();
+
   fNameBuffer
-    = TG4GeometryServices::Instance()->UserVolumeName(
-        GetCurrentPhysicalVolume()->GetLogicalVolume()->GetName());
+    = TG4GeometryServices::Instance()->UserVolumeName(lv->GetName());
 
   return fNameBuffer.data();
 }
@@ -450,6 +608,10 @@ const char* TG4StepManager::CurrentVolOffName(Int_t off) const
   G4VPhysicalVolume* mother = GetCurrentOffPhysicalVolume(off); 
 
   if ( mother ) {
+    const TG4VolumeDescriptor* descriptor
+      = fSDServices->GetVolumeDescriptor(mother->GetLogicalVolume());
+    if ( descriptor ) return descriptor->GetUserVolumeName().data();
+
     fNameBuffer
       = TG4GeometryServices::Instance()->UserVolumeName(
           mother->GetLogicalVolume()->GetName());
@@ -464,36 +626,45 @@ const char* TG4StepManager::CurrentVolOffName(Int_t off) const
 const char* TG4StepManager::CurrentVolPath()
 { 
 /// Return the current volume path.
+/// The path fragments are cached per level of the navigation history
+/// and only the levels below the first changed one are rebuilt.
+
+  UpdateVolPathCache();
+
+  G4int nofLevels = fVolPathVolumes.size();
+  if ( fVolPathNofLevels == nofLevels ) return fVolPath.data();
 
   TG4GeometryServices* geometryServices = TG4GeometryServices::Instance();
 
-  // Get current touchable
-  const G4VTouchable* touchable = GetCurrentTouchable();
-  
-  // Check touchable depth
-  //
-  G4int depth = touchable->GetHistoryDepth();
-  
-  // Compose the path
-  //
-  fNameBuffer = "";
-  for ( G4int i=0; i<depth; i++ ) {
-    G4VPhysicalVolume* physVolume = touchable->GetHistory()->GetVolume(i);
-    fNameBuffer += "/";
-    fNameBuffer
-      += geometryServices->UserVolumeName(physVolume->GetName());
-    fNameBuffer += "_";
-    TG4Globals::AppendNumberToString(fNameBuffer, physVolume->GetCopyNo());
-  }     
+  // Keep the valid part of the path
+  fVolPathLengths.resize(fVolPathNofLevels);
+  fVolPath.resize(fVolPathNofLevels ? fVolPathLengths.back() : 0);
+
+  // Compose the rest of the path
+  for ( G4int i=fVolPathNofLevels; i<nofLevels; i++ ) {
+    fVolPath += "/";
+    fVolPath
+      += geometryServices->UserVolumeName(fVolPathVolumes[i]->GetName());
+    fVolPath += "_";
+    TG4Globals::AppendNumberToString(fVolPath, fVolPathCopyNos[i]);
+    fVolPathLengths.push_back(fVolPath.size());
+  }
+  fVolPathNofLevels = nofLevels;
 
-  // Add current volume to the path
-  G4VPhysicalVolume* curPhysVolume = GetCurrentPhysicalVolume(); 
-  fNameBuffer += "/";
-  fNameBuffer += geometryServices->UserVolumeName(curPhysVolume->GetName());
-  fNameBuffer += "_";
-  TG4Globals::AppendNumberToString(fNameBuffer, curPhysVolume->GetCopyNo());
+  return fVolPath.data();
+}
 
-  return fNameBuffer.data();
+//_____________________________________________________________________________
+ULong64_t TG4StepManager::CurrentVolPathHash()
+{ 
+/// Return the hash of the current volume path computed from the volume IDs
+/// and copy numbers of all volumes along the path. 
+/// Unlike CurrentVolPath(), it does not require any string operations;
+/// it is updated incrementally in the same way as the volume path.
+
+  UpdateVolPathCache();
+
+  return fVolPathHashes.back();
 }
 
 //_____________________________________________________________________________
@@ -534,7 +705,18 @@ Int_t TG4StepManager::CurrentMaterial(Float_t &a, Float_t &z, Float_t &dens,
 /// \param absl  The absorption length in cm
 
   G4VPhysicalVolume* physVolume = GetCurrentPhysicalVolume(); 
-    
+
+  const TG4VolumeDescriptor* descriptor
+    = fSDServices->GetVolumeDescriptor(physVolume->GetLogicalVolume());
+  if ( descriptor ) {
+    a = descriptor->GetEffA();
+    z = descriptor->GetEffZ();
+    dens = descriptor->GetDensity();
+    radl = descriptor->GetRadLength();
+    absl = 0.;  // this parameter is not defined in Geant4
+    return descriptor->GetNofElements();
+  }
+
   G4Material* material 
     = physVolume->GetLogicalVolume()->GetMaterial();
 
@@ -560,8 +742,11 @@ Int_t TG4StepManager::CurrentMedium() const
 {   
 /// Return the medium ID 
 
-  return TG4SDServices::Instance()->GetMediumID(
-            GetCurrentPhysicalVolume()->GetLogicalVolume());
+  G4LogicalVolume* lv = GetCurrentPhysicalVolume()->GetLogicalVolume();
+  const TG4VolumeDescriptor* descriptor = fSDServices->GetVolumeDescriptor(lv);
+  if ( descriptor ) return descriptor->GetMediumID();
+
+  return fSDServices->GetMediumID(lv);
 }
 
 //_____________________________________________________________________________
@@ -575,20 +760,13 @@ void TG4StepManager::Gmtod(Float_t* xm, Float_t* xd, Int_t iflag)
 ///              - IFLAG=1  convert coordinates,                                 \n
 ///              - IFLAG=2  convert direction cosinus
 ///
- 
 
-  G4double* dxm = TG4GeometryServices::Instance()->CreateG4doubleArray(xm, 3);
-  G4double* dxd = TG4GeometryServices::Instance()->CreateG4doubleArray(xd, 3);
+  G4double dxm[3] = { xm[0], xm[1], xm[2] };
+  G4double dxd[3];
 
-  Gmtod(dxm, dxd, iflag);
+  Gmtod(1, dxm, dxd, iflag);
 
-  for ( G4int i=0; i<3; i++ ) {
-    xm[i] = dxm[i]; 
-    xd[i] = dxd[i];
-  }   
-
-  delete [] dxm;
-  delete [] dxd;
+  for ( G4int i=0; i<3; i++ ) xd[i] = dxd[i];
 } 
  
 //_____________________________________________________________________________
@@ -603,33 +781,7 @@ void TG4StepManager::Gmtod(Double_t* xm, Double_t* xd, Int_t iflag)
 ///              - IFLAG=2  convert direction cosinus
 ///
 
-#ifdef MCDEBUG
-  if ( iflag != 1 && iflag != 2 ) {
-      TString text = "iflag=";
-      text += iflag;
-      TG4Globals::Warning(
-        "TG4StepManager", "Gmtod", text + " is different from 1..2.");
-      return;        
-  }        
-#endif
-
-  const G4AffineTransform& affineTransform
-    = GetCurrentTouchable()->GetHistory()->GetTopTransform();
-
-  G4ThreeVector theGlobalPoint(xm[0]* TG4G3Units::Length(),
-                               xm[1]* TG4G3Units::Length(),                       
-                               xm[2]* TG4G3Units::Length()); 
-  G4ThreeVector theLocalPoint;
-  if ( iflag == 1 ) 
-    theLocalPoint = affineTransform.TransformPoint(theGlobalPoint);
-  else {
-    // if ( iflag == 2)
-    theLocalPoint = affineTransform.TransformAxis(theGlobalPoint);
-  }  
-
-  xd[0] = theLocalPoint.x()/TG4G3Units::Length();
-  xd[1] = theLocalPoint.y()/TG4G3Units::Length();
-  xd[2] = theLocalPoint.z()/TG4G3Units::Length();
+  Gmtod(1, xm, xd, iflag);
 } 
  
 //_____________________________________________________________________________
@@ -643,19 +795,12 @@ void TG4StepManager::Gdtom(Float_t* xd, Float_t* xm, Int_t iflag)
 ///              - IFLAG=1  convert coordinates,                                 \n
 ///              - IFLAG=2  convert direction cosinus
 
+  G4double dxd[3] = { xd[0], xd[1], xd[2] };
+  G4double dxm[3];
 
-  G4double* dxd = TG4GeometryServices::Instance()->CreateG4doubleArray(xd, 3);
-  G4double* dxm = TG4GeometryServices::Instance()->CreateG4doubleArray(xm, 3);
-
-  Gdtom(dxd, dxm, iflag);
-
-  for ( G4int i=0; i<3; i++ ) {
-    xd[i] = dxd[i];
-    xm[i] = dxm[i]; 
-  }   
+  Gdtom(1, dxd, dxm, iflag);
 
-  delete [] dxd;
-  delete [] dxm;
+  for ( G4int i=0; i<3; i++ ) xm[i] = dxm[i];
 } 
  
 //_____________________________________________________________________________
@@ -667,35 +812,97 @@ void TG4StepManager::Gdtom(Double_t* xd, Double_t* xm, Int_t iflag)
 /// \param xm    Computed coordinates in the world reference system
 /// \param iflag The option: 
 ///              - IFLAG=1  convert coordinates,                                 \n
+///              - IFLAG=2  convert direction cosinus
+
+  Gdtom(1, xd, xm, iflag);
+} 
+
+//_____________________________________________________________________________
+G4AffineTransform TG4StepManager::GetCurrentTransform() const
+{
+/// Return the transformation from the world reference frame 
+/// to the current volume reference frame.
+/// It can be kept by the user and passed to the static Gmtod(), Gdtom()
+/// functions while the volume placement does not change.
+
+  return GetCurrentTouchable()->GetHistory()->GetTopTransform();
+}
+
+//_____________________________________________________________________________
+void TG4StepManager::Gmtod(Int_t n, const Double_t* xm, Double_t* xd, 
+                           Int_t iflag) const
+{ 
+/// Transform n positions or directions from the world reference frame
+/// to the current volume reference frame.
+/// \param n     The number of points
+/// \param xm    Known coordinates in the world reference system
+///              (x0, y0, z0, x1, y1, z1, ...)
+/// \param xd    Computed coordinates in the daughter reference system
+/// \param iflag The option: 
+///              - IFLAG=1  convert coordinates,                                 \n
 ///              - IFLAG=2  convert direction cosinus
 
 #ifdef MCDEBUG
-  if ( iflag != 1 && iflag != 2 ) {
-      TString text = "iflag=";
-      text += iflag;
-      TG4Globals::Warning(
-        "TG4StepManager", "Gmtod", text + " is different from 1..2.");
-      return;        
-  }        
+  if ( ! CheckTransformFlag(iflag, "Gmtod") ) return;
 #endif
 
-  const G4AffineTransform& affineTransform
-    = GetCurrentTouchable()->GetHistory()->GetTopTransform().Inverse();
+  TransformPoints(
+    GetCurrentTouchable()->GetHistory()->GetTopTransform(), n, xm, xd, iflag);
+} 
 
-  G4ThreeVector theLocalPoint(xd[0]*TG4G3Units::Length(),
-                              xd[1]*TG4G3Units::Length(),
-                              xd[2]*TG4G3Units::Length()); 
-  G4ThreeVector theGlobalPoint;
-  if ( iflag == 1 )
-    theGlobalPoint = affineTransform.TransformPoint(theLocalPoint);
-  else {
-    // if( iflag == 2)
-    theGlobalPoint = affineTransform.TransformAxis(theLocalPoint);
-  }    
+//_____________________________________________________________________________
+void TG4StepManager::Gdtom(Int_t n, const Double_t* xd, Double_t* xm, 
+                           Int_t iflag) const
+{ 
+/// Transform n positions or directions from the current volume reference 
+/// frame to the world reference frame.
+/// \param n     The number of points
+/// \param xd    Known coordinates in the daughter reference system
+///              (x0, y0, z0, x1, y1, z1, ...)
+/// \param xm    Computed coordinates in the world reference system
+/// \param iflag The option: 
+///              - IFLAG=1  convert coordinates,                                 \n
+///              - IFLAG=2  convert direction cosinus
+
+#ifdef MCDEBUG
+  if ( ! CheckTransformFlag(iflag, "Gdtom") ) return;
+#endif
 
-  xm[0] = theGlobalPoint.x()/TG4G3Units::Length();
-  xm[1] = theGlobalPoint.y()/TG4G3Units::Length();
-  xm[2] = theGlobalPoint.z()/TG4G3Units::Length();
+  TransformPoints(
+    GetCurrentTouchable()->GetHistory()->GetTopTransform().Inverse(), 
+    n, xd, xm, iflag);
+} 
+
+//_____________________________________________________________________________
+void TG4StepManager::Gmtod(const G4AffineTransform& transform,
+                           Int_t n, const Double_t* xm, Double_t* xd, 
+                           Int_t iflag)
+{ 
+/// Transform n positions or directions from the world reference frame
+/// to the volume reference frame defined by the given transformation
+/// (see GetCurrentTransform()).
+
+#ifdef MCDEBUG
+  if ( ! CheckTransformFlag(iflag, "Gmtod") ) return;
+#endif
+
+  TransformPoints(transform, n, xm, xd, iflag);
+} 
+
+//_____________________________________________________________________________
+void TG4StepManager::Gdtom(const G4AffineTransform& transform,
+                           Int_t n, const Double_t* xd, Double_t* xm, 
+                           Int_t iflag)
+{ 
+/// Transform n positions or directions from the volume reference frame
+/// defined by the given transformation (see GetCurrentTransform()) 
+/// to the world reference frame.
+
+#ifdef MCDEBUG
+  if ( ! CheckTransformFlag(iflag, "Gdtom") ) return;
+#endif
+
+  TransformPoints(transform.Inverse(), n, xd, xm, iflag);
 } 
  
 //_____________________________________________________________________________
@@ -1179,6 +1386,51 @@ Bool_t TG4StepManager::IsNewTrack() const
     return false;
 }
 
+//_____________________________________________________________________________
+void TG4StepManager::FillStepRecord(TG4StepRecord& record) const
+{
+/// Fill the given record with the current step properties.
+/// The values are the same as returned by the individual TVirtualMC
+/// step methods, they are retrieved here with one call.
+
+#ifdef MCDEBUG
+  CheckTrack();
+#endif
+
+  TrackPosition(record.fPosition[0], record.fPosition[1], record.fPosition[2]);
+  record.fPosition[3] = TrackTime();
+  TrackMomentum(record.fMomentum[0], record.fMomentum[1], record.fMomentum[2],
+                record.fMomentum[3]);
+
+  record.fEdep = Edep();
+  record.fNIELEdep = NIELEdep();
+  record.fStepLength = TrackStep();
+  record.fTrackLength = TrackLength();
+  record.fCharge = TrackCharge();
+  record.fPdg = TrackPid();
+
+  // track status bits
+  // (the post step point is available only with G4 step)
+  Int_t status = 0;
+  if ( IsTrackInside() )      status |= TG4StepRecord::kInside;
+  if ( IsTrackEntering() )    status |= TG4StepRecord::kEntering;
+  if ( IsTrackExiting() )     status |= TG4StepRecord::kExiting;
+  if ( fStep && IsTrackOut() ) status |= TG4StepRecord::kOut;
+  if ( IsTrackDisappeared() ) status |= TG4StepRecord::kDisappeared;
+  if ( IsTrackStop() )        status |= TG4StepRecord::kStop;
+  if ( IsTrackAlive() )       status |= TG4StepRecord::kAlive;
+  if ( IsNewTrack() )         status |= TG4StepRecord::kNewTrack;
+  record.fStatus = status;
+
+  // volume IDs and copy numbers of the current volume and its mothers
+  record.fNofLevels = fgStepRecordNofLevels;
+  for ( G4int i=0; i<fgStepRecordNofLevels; ++i ) {
+    Int_t copyNo = 0;
+    record.fVolumeID[i] = CurrentVolOffID(i, copyNo);
+    record.fCopyNo[i] = copyNo;
+  }
+}
+
 //_____________________________________________________________________________
 Int_t TG4StepManager::NSecondaries() const
 {
@@ -1352,13 +1604,13 @@ Int_t TG4StepManager::StepProcesses(TArrayI& processes) const
   for ( G4int i=0; i<nofAlongStep; i++ ) {
     G4VProcess* g4Process = (*processVector)[i];    
     // do not fill transportation along step process
-    if ( g4Process && g4Process->GetProcessName() != "Transportation" )
+    if ( g4Process && ! physicsManager->IsTransportation(g4Process) )
       processes[counter++] = physicsManager->GetMCProcess(g4Process);
   }
     
   // fill array with optical photon information
   if ( fStep->GetTrack()->GetDefinition() == G4OpticalPhoton::Definition() &&
-       kpLastProcess->GetProcessName() == "Transportation" &&
+       physicsManager->IsTransportation(kpLastProcess) &&
        physicsManager->IsOpBoundaryProcess() ) {
        
      // add light scattering anbd reflection/absorption as additional processes
@@ -0,0 +1,29 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4VScoringHandler.cxx
+/// \brief Implementation of the TG4VScoringHandler class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4VScoringHandler.h"
+
+//_____________________________________________________________________________
+TG4VScoringHandler::TG4VScoringHandler(G4int nofDenseCopies)
+  : fNofDenseCopies(nofDenseCopies)
+{
+/// Standard constructor
+/// \param nofDenseCopies  The number of copies accumulated in the flat array
+}
+
+//_____________________________________________________________________________
+TG4VScoringHandler::~TG4VScoringHandler() 
+{
+/// Destructor
+}
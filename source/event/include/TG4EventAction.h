@@ -17,6 +17,7 @@
 
 #include "TG4Verbose.h"
 #include "TG4EventActionMessenger.h"
+#include "TG4MemoryStatistics.h"
 
 #include <TStopwatch.h>
 
@@ -68,6 +69,9 @@ class TG4EventAction : public G4UserEventAction,
     TG4EventActionMessenger   fMessenger; ///< messenger
     TStopwatch  fTimer;          ///< timer
 
+    /// Memory accounting (activated with printMemory)
+    TG4MemoryStatistics  fMemoryStatistics;
+
     /// Cached pointer to thread-local VMC application
     TVirtualMCApplication*  fMCApplication;
 
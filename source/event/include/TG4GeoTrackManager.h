@@ -16,16 +16,30 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include "TG4Verbose.h"
+#include "TG4GeoTrackManagerMessenger.h"
 
+#include <G4ThreeVector.hh>
 #include <globals.hh>
 
-class G4Step;
+#include <vector>
+#include <unordered_map>
 
-class TVirtualGeoTrack;
+class G4Step;
+class G4StepPoint;
+class G4Track;
 
 /// \ingroup event
 /// \brief The manager class for collecting TGeo tracks for visualization
 ///
+/// The track points are recorded during event in compact buffers 
+/// (in single precision and G3 units) filled directly from G4Step;
+/// they are converted in TGeo tracks via FillGeoTracks() called at
+/// the end of event.
+///
+/// The number of recorded points can be reduced with the minimum 
+/// distance between points and the minimum change of the track direction,
+/// and it can be limited per track and per event (the memory budget).
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 class TG4GeoTrackManager : public TG4Verbose 
@@ -36,28 +50,106 @@ class TG4GeoTrackManager : public TG4Verbose
 
     // methods
     void UpdateRootTrack(const G4Step* step);
+    void FillGeoTracks();
+    void Reset();
+
+    // set methods
+    void SetMinPointDistance(G4double distance);
+    void SetMinAngle(G4double angle);
+    void SetMaxNofPoints(G4int maxNofPoints);
+    void SetMaxMemory(G4int megaBytes);
+
+    // get methods
+    G4int GetNofTracks() const;
+    G4int GetNofPoints() const;
+    size_t GetNofBytes() const;
 
   private:
+    /// The compact track point (in G3 units)
+    struct TrackPoint {
+      G4float fX; ///< x position
+      G4float fY; ///< y position
+      G4float fZ; ///< z position
+      G4float fT; ///< global time
+    };
+  
+    /// The recorded track
+    struct TrackRecord {
+      G4int  fTrackId;     ///< VMC track ID
+      G4int  fParentId;    ///< VMC parent track ID
+      G4int  fG4ParentId;  ///< G4 parent track ID
+      G4int  fPdg;         ///< PDG encoding
+      G4bool fIsTruncated; ///< info if some points were dropped due to limits
+      G4ThreeVector fLastDirection;  ///< momentum direction at the last point
+      std::vector<TrackPoint> fPoints; ///< recorded points
+    };
+
     /// Not implemented
     TG4GeoTrackManager(const TG4GeoTrackManager& right);
     /// Not implemented
     TG4GeoTrackManager& operator=(const TG4GeoTrackManager& right);
 
+    // methods
+    void SetCurrentTrack(const G4Track* track);
+    void AddPoint(TrackRecord& record, const G4StepPoint* point);
+
     // static data members
-    /// minimum point distance to store a point in TGeo track 
+    /// default minimum point distance to store a point in TGeo track 
     static const G4double  fgkMinPointDistance; 
 
     //
     // data members
     
-    /// control to collect Root tracks
-    G4bool fCollectTracks;
+    /// messenger
+    TG4GeoTrackManagerMessenger  fMessenger;
+
+    /// minimum point distance squared (in G3 units)
+    G4double  fMinPointDistance2;
+
+    /// cosine of the minimum direction change (1. if not applied)
+    G4double  fCosMinAngle;
 
-    /// current Root track
-    TVirtualGeoTrack* fCurrentTGeoTrack;
+    /// maximum number of points per track (0 = no limit)
+    G4int  fMaxNofPoints;
 
-    /// parent of the current Root track
-    TVirtualGeoTrack* fParentTGeoTrack;
+    /// maximum number of points per event given by the memory budget 
+    /// (0 = no limit)
+    size_t  fMaxNofEventPoints;
+
+    /// recorded tracks in the order of their creation
+    std::vector<TrackRecord>  fTrackRecords;
+
+    /// map of G4 track ID to the index in fTrackRecords
+    std::unordered_map<G4int, G4int>  fTrackIndices;
+
+    /// index of the current track record in fTrackRecords
+    G4int  fCurrentIndex;
+
+    /// G4 ID of the current track
+    G4int  fCurrentG4TrackID;
+
+    /// number of recorded points in the event
+    size_t  fNofPoints;
+
+    /// info if the memory budget was reached in the event
+    G4bool  fIsMemoryExhausted;
 };
 
+// inline functions
+
+inline G4int TG4GeoTrackManager::GetNofTracks() const {
+  /// Return the number of tracks recorded in the event
+  return fTrackRecords.size();
+}
+
+inline G4int TG4GeoTrackManager::GetNofPoints() const {
+  /// Return the number of points recorded in the event
+  return fNofPoints;
+}
+
+inline size_t TG4GeoTrackManager::GetNofBytes() const {
+  /// Return the (approximate) memory used by the tracks recorded in the event
+  return fTrackRecords.size()*sizeof(TrackRecord) + fNofPoints*sizeof(TrackPoint);
+}
+
 #endif //TG4_GEO_TRAK_MANAGER_H
@@ -0,0 +1,65 @@
+#ifndef TG4_GEO_TRACK_MANAGER_MESSENGER_H
+#define TG4_GEO_TRACK_MANAGER_MESSENGER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4GeoTrackManagerMessenger.h
+/// \brief Definition of the TG4GeoTrackManagerMessenger class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class TG4GeoTrackManager;
+
+class G4UIdirectory;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+
+/// \ingroup event
+/// \brief Messenger class that defines commands for TG4GeoTrackManager.
+///
+/// Implements commands
+/// - /mcTracking/geoTracks/minPointDistance [value] [unit]
+/// - /mcTracking/geoTracks/minAngle [value] [unit]
+/// - /mcTracking/geoTracks/maxNofPoints [nofPoints]
+/// - /mcTracking/geoTracks/maxMemory [MBytes]
+/// 
+/// \author I. Hrivnacova; IPN, Orsay
+ 
+class TG4GeoTrackManagerMessenger: public G4UImessenger
+{
+  public:
+    TG4GeoTrackManagerMessenger(TG4GeoTrackManager* geoTrackManager);
+    virtual ~TG4GeoTrackManagerMessenger();
+   
+    // methods 
+    virtual void SetNewValue(G4UIcommand* command, G4String string);
+    
+  private:
+    /// Not implemented
+    TG4GeoTrackManagerMessenger();
+    /// Not implemented
+    TG4GeoTrackManagerMessenger(const TG4GeoTrackManagerMessenger& right);
+    /// Not implemented
+    TG4GeoTrackManagerMessenger& operator=(
+                               const TG4GeoTrackManagerMessenger& right);
+
+    // data members
+    TG4GeoTrackManager*         fGeoTrackManager;     ///< associated class 
+    G4UIdirectory*              fDirectory;           ///< command directory
+    G4UIcmdWithADoubleAndUnit*  fMinPointDistanceCmd; ///< command: minPointDistance
+    G4UIcmdWithADoubleAndUnit*  fMinAngleCmd;         ///< command: minAngle
+    G4UIcmdWithAnInteger*       fMaxNofPointsCmd;     ///< command: maxNofPoints
+    G4UIcmdWithAnInteger*       fMaxMemoryCmd;        ///< command: maxMemory
+};
+
+#endif //TG4_GEO_TRACK_MANAGER_MESSENGER_H
@@ -0,0 +1,126 @@
+#ifndef TG4_MEMORY_STATISTICS_H
+#define TG4_MEMORY_STATISTICS_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4MemoryStatistics.h
+/// \brief Definition of the TG4MemoryStatistics class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <globals.hh>
+
+class G4Event;
+
+class TVirtualMCStack;
+
+/// \ingroup event
+/// \brief The per event memory accounting of the track and stack objects
+///
+/// At the end of each event the number of objects and the memory held
+/// is collected for:
+/// - TG4TrackInformation objects (the maximum number of live objects 
+///   in the event and the memory of their allocator)
+/// - TParticle objects in the VMC stack (estimated from the number 
+///   of tracks in the stack)
+/// - Geant4 tracks (the number of tracks processed in the event and 
+///   the memory of the G4Track and G4DynamicParticle allocators)
+/// - trajectories (Geant4 trajectories and the tracks recorded for
+///   TGeo visualization)
+///
+/// The hits are managed by the user application and they are not
+/// accounted; the resident memory of the process is printed for reference.
+///
+/// The statistics are thread-local; the high-water marks are merged 
+/// at the end of run in TG4RunAction::EndOfRunAction() and printed 
+/// on master, both as a maximum per thread and as a sum over threads.
+///
+/// The accounting is activated with /mcEvent/printMemory.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4MemoryStatistics
+{
+  public:
+    /// The accounted categories
+    enum ECategory {
+      kTrackInformation, ///< TG4TrackInformation objects
+      kStackParticles,   ///< TParticle objects in the VMC stack
+      kG4Tracks,         ///< Geant4 tracks and dynamic particles
+      kTrajectories,     ///< trajectories and recorded TGeo tracks
+      kNofCategories     ///< number of categories
+    };
+
+  public:
+    TG4MemoryStatistics();
+    ~TG4MemoryStatistics();
+
+    // static methods
+    static TG4MemoryStatistics* Instance();
+    static void PrintMerged();
+    static void ClearMerged();
+
+    // methods
+    void BeginOfEvent();
+    void EndOfEvent(const G4Event* event, TVirtualMCStack* mcStack);
+    void Print(G4int eventID) const;
+    void Merge();
+
+    // get methods
+    G4long GetCount(ECategory category) const;
+    size_t GetBytes(ECategory category) const;
+    size_t GetMaxBytes(ECategory category) const;
+
+  private:
+    /// Not implemented
+    TG4MemoryStatistics(const TG4MemoryStatistics& right);
+    /// Not implemented
+    TG4MemoryStatistics& operator=(const TG4MemoryStatistics& right);
+
+    // static methods
+    static G4String GetCategoryName(G4int category);
+
+    // static data members
+    static G4ThreadLocal TG4MemoryStatistics*  fgInstance; ///< this instance
+    static size_t  fgMaxBytes[kNofCategories]; ///< merged max bytes per thread
+    static size_t  fgSumBytes[kNofCategories]; ///< merged sum of max bytes
+    static G4int   fgNofThreads;               ///< number of merged threads
+
+    // data members
+    G4long  fCounts[kNofCategories];   ///< object counts in the last event
+    size_t  fBytes[kNofCategories];    ///< bytes in the last event
+    G4long  fMaxCounts[kNofCategories];///< high-water mark of counts
+    size_t  fMaxBytes[kNofCategories]; ///< high-water mark of bytes
+    G4int   fNofEvents;                ///< number of accounted events
+};
+
+// inline methods
+
+inline TG4MemoryStatistics* TG4MemoryStatistics::Instance() { 
+  /// Return this instance
+  return fgInstance; 
+}
+
+inline G4long TG4MemoryStatistics::GetCount(ECategory category) const {
+  /// Return the number of objects of given category in the last event
+  return fCounts[category];
+}
+
+inline size_t TG4MemoryStatistics::GetBytes(ECategory category) const {
+  /// Return the memory of given category in the last event (in bytes)
+  return fBytes[category];
+}
+
+inline size_t TG4MemoryStatistics::GetMaxBytes(ECategory category) const {
+  /// Return the high-water mark of the memory of given category (in bytes)
+  return fMaxBytes[category];
+}
+
+#endif //TG4_MEMORY_STATISTICS_H
@@ -16,10 +16,13 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include "TG4Verbose.h"
+#include "TG4StackingRule.h"
 
 #include <G4UserStackingAction.hh>
 #include <globals.hh>
 
+#include <vector>
+
 class G4Track;
 class G4TrackStack;
 
@@ -39,6 +42,15 @@ class G4TrackStack;
 /// subsequently and get successive track IDs:                               \n
 /// n, n+1, n+2, n+3, ..., n+m  
 ///
+/// The secondary particles can be further classified according to 
+/// the stacking rules (see TG4StackingRule): the first rule matching 
+/// the track defines the stage in which the track will be processed 
+/// (relative to the current stage) or kills the track. The later stages
+/// are mapped to the Geant4 waiting stacks and the next primary particle
+/// is transfered to the urgent stack only when all of them are empty.
+/// The number of tracks classified in each stage is accumulated
+/// and can be printed via PrintStatistics().
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include "TG4SpecialStackingActionMessenger.h"
@@ -55,6 +67,12 @@ class TG4SpecialStackingAction : public G4UserStackingAction,
     void NewStage();
     void PrepareNewEvent();
     
+    void AddRule(const TG4StackingRule& rule);
+    void ClearRules();
+    void PrintRules() const;
+    void PrintStatistics() const;
+    void ResetStatistics();
+    
     // set method
     void SetSkipNeutrino(G4bool skipNeutrino);
     
@@ -67,11 +85,26 @@ class TG4SpecialStackingAction : public G4UserStackingAction,
     /// Not implemented
     TG4SpecialStackingAction& operator=(const TG4SpecialStackingAction& right);
 
+    // methods
+    G4ClassificationOfNewTrack GetClassification(G4int stage) const;
+    void  UpdateWaitingStacks();
+
     // data members
     TG4SpecialStackingActionMessenger  fMessenger; ///< messenger
     G4int   fStage;        ///< stage number
     G4bool  fSkipNeutrino; ///< option to skip tracking of neutrino
-    
+
+    /// The stacking rules
+    std::vector<TG4StackingRule>  fRules;
+
+    /// The number of additional waiting stacks set to G4StackManager
+    G4int   fNofAdditionalWaitingStacks;
+
+    /// The number of tracks classified in each stage
+    G4long  fNofStageTracks[TG4StackingRule::kMaxStage+1];
+    G4long  fNofKilledTracks; ///< the number of killed tracks
+    G4long  fNofStages;       ///< the number of processed stages
+    G4long  fNofEvents;       ///< the number of processed events
 };
 
 // inline functions
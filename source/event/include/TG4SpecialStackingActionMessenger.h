@@ -23,12 +23,19 @@ class TG4SpecialStackingAction;
 class G4UIdirectory;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithABool;
+class G4UIcmdWithoutParameter;
+class G4UIcommand;
 
 /// \ingroup event
 /// \brief Messenger class that defines commands for TG4StackingAction.
 ///
-/// Implements command:
+/// Implements commands:
 /// - /mcTracking/skipNeutrino [true|false]
+/// - /mcTracking/stackingRules/add stage [pdg] [minEkin] [maxEkin] [region] [minTime]
+/// - /mcTracking/stackingRules/clear
+/// - /mcTracking/stackingRules/print
+/// - /mcTracking/stackingRules/printStatistics
+/// - /mcTracking/stackingRules/resetStatistics
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -54,6 +61,16 @@ class TG4SpecialStackingActionMessenger: public G4UImessenger
     // data members
     TG4SpecialStackingAction*  fStackingAction;  ///< associated class  
     G4UIcmdWithABool*          fSkipNeutrinoCmd; ///< command: skipNeutrino
+    G4UIdirectory*             fRulesDirectory;  ///< command directory
+    G4UIcommand*               fAddRuleCmd;      ///< command: stackingRules/add
+    G4UIcmdWithoutParameter*   fClearRulesCmd;   ///< command: stackingRules/clear
+    G4UIcmdWithoutParameter*   fPrintRulesCmd;   ///< command: stackingRules/print
+
+    /// command: stackingRules/printStatistics
+    G4UIcmdWithoutParameter*   fPrintStatisticsCmd;
+
+    /// command: stackingRules/resetStatistics
+    G4UIcmdWithoutParameter*   fResetStatisticsCmd;
 };
 
 #endif //TG4_SPECIAL_STACKING_ACTION_MESSENGER_H
@@ -0,0 +1,101 @@
+#ifndef TG4_STACKING_RULE_H
+#define TG4_STACKING_RULE_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4StackingRule.h
+/// \brief Definition of the TG4StackingRule class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include <globals.hh>
+
+class G4Track;
+class G4Region;
+
+/// \ingroup event
+/// \brief The rule for classification of new secondary tracks 
+/// applied in TG4SpecialStackingAction.
+///
+/// The rule matches the tracks with a given PDG code (all particles if 0),
+/// with the kinetic energy in a given window, created in a given region 
+/// (all regions if the region name is empty) and with the global time
+/// greater or equal to a given value.                                     \n
+/// The matched tracks are moved to the given stage, which is relative
+/// to the current one: 0 - urgent stack (current stage), 1 - waiting stack 
+/// (next stage), 2 - kMaxStage - additional waiting stacks;
+/// or killed if the stage is set to kKill.
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+class TG4StackingRule
+{
+  public:
+    /// The stage value for killing the matched tracks
+    enum { kKill = -1 };
+    /// The maximum stage (limited by Geant4 additional waiting stacks)
+    enum { kMaxStage = 9 };
+
+  public:
+    TG4StackingRule(G4int stage, G4int pdg = 0);
+    ~TG4StackingRule();
+
+    // methods
+    G4bool Match(const G4Track* track) const;
+    void   Print() const;
+
+    // set methods
+    void SetEkinRange(G4double minEkin, G4double maxEkin);
+    void SetRegionName(const G4String& regionName);
+    void SetMinGlobalTime(G4double minGlobalTime);
+
+    // get methods
+    G4int  GetStage() const;
+
+  private:
+    // methods
+    void ResolveRegion() const;
+
+    // data members
+    G4int     fStage;         ///< the target stage (or kKill)
+    G4int     fPdg;           ///< PDG encoding (all particles if 0)
+    G4double  fMinEkin;       ///< minimum kinetic energy
+    G4double  fMaxEkin;       ///< maximum kinetic energy
+    G4double  fMinGlobalTime; ///< minimum global time
+    G4String  fRegionName;    ///< region name (all regions if empty)
+    mutable G4Region* fRegion;     ///< the region resolved from its name
+    mutable G4bool    fIsResolved; ///< info whether the region was resolved
+};
+
+// inline methods
+
+inline void TG4StackingRule::SetEkinRange(G4double minEkin, G4double maxEkin) {
+  /// Set the kinetic energy window (in Geant4 units)
+  fMinEkin = minEkin; fMaxEkin = maxEkin;
+}
+
+inline void TG4StackingRule::SetRegionName(const G4String& regionName) {
+  /// Set the name of the region where the track has to be created
+  fRegionName = regionName;
+  fRegion = 0;
+  fIsResolved = false;
+}
+
+inline void TG4StackingRule::SetMinGlobalTime(G4double minGlobalTime) {
+  /// Set the minimum global time (in Geant4 units)
+  fMinGlobalTime = minGlobalTime;
+}
+
+inline G4int TG4StackingRule::GetStage() const {
+  /// Return the target stage (or kKill)
+  return fStage;
+}
+
+#endif //TG4_STACKING_RULE_H
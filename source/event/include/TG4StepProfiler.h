@@ -0,0 +1,169 @@
+#ifndef TG4_STEP_PROFILER_H
+#define TG4_STEP_PROFILER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4StepProfiler.h
+/// \brief Definition of the TG4StepProfiler class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <globals.hh>
+
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <chrono>
+
+class G4Step;
+class G4VProcess;
+class G4ParticleDefinition;
+
+/// \ingroup event
+/// \brief The stepping profiler
+///
+/// Counts the steps and accumulates the wall time per logical volume, 
+/// per particle type and per process limiting the step. 
+/// The time of a step is measured from StartStep(), called at the end 
+/// of the previous stepping action or of the pre-tracking action, 
+/// to ProfileStep(), so only the G4 stepping (including sensitive detectors)
+/// is measured, without the user stepping, tracking and stacking actions;
+/// with sampling set to N, the time is measured only for each N-th step 
+/// and it is scaled by N.
+///
+/// The counters are thread-local (one profiler per stepping action);
+/// they are merged at the end of run in TG4RunAction::EndOfRunAction(),
+/// where the top N report is printed and the CSV table is written 
+/// if the output file name is set.
+/// The merged counters can be retrieved via GetVolumeCounters(),
+/// GetParticleCounters() and GetProcessCounters() for an automated tuning
+/// of regions, cuts or max step limits.
+///
+/// The profiling is activated with /mcControl/setStepProfiling.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4StepProfiler
+{
+  public:
+    /// The step counter
+    struct Counter {
+      Counter() : fNofSteps(0), fTime(0.) {}
+      G4long   fNofSteps;  ///< the number of steps
+      G4double fTime;      ///< the wall time (in s)
+    };
+
+    /// The merged counters per volume, particle or process name
+    typedef std::map<G4String, Counter>  CounterMap;
+
+  public:
+    TG4StepProfiler();
+    ~TG4StepProfiler();
+
+    // static methods
+    static void SetIsActive(G4bool isActive);
+    static void SetSampling(G4int sampling);
+    static void SetNofTop(G4int nofTop);
+    static void SetOutputFileName(const G4String& fileName);
+    static G4bool IsActive();
+
+    static void PrintReport();
+    static void WriteTable();
+    static void ClearMerged();
+    static const CounterMap& GetVolumeCounters();
+    static const CounterMap& GetParticleCounters();
+    static const CounterMap& GetProcessCounters();
+
+    // methods
+    void StartStep();
+    void ProfileStep(const G4Step* step);
+    void Merge();
+
+  private:
+    /// Not implemented
+    TG4StepProfiler(const TG4StepProfiler& right);
+    /// Not implemented
+    TG4StepProfiler& operator=(const TG4StepProfiler& right);
+
+    // static methods
+    static void PrintTop(const G4String& title, const CounterMap& counters);
+
+    // static data members
+    static G4bool    fgIsActive;   ///< activation of profiling
+    static G4int     fgSampling;   ///< the time sampling
+    static G4int     fgNofTop;     ///< the number of entries in the report
+    static G4String  fgOutputFileName; ///< the CSV output file name
+    static CounterMap  fgVolumeCounters;   ///< merged volume counters
+    static CounterMap  fgParticleCounters; ///< merged particle counters
+    static CounterMap  fgProcessCounters;  ///< merged process counters
+
+    // data members
+    /// the step counter used for sampling
+    G4long  fStepCounter;
+
+    /// the start time of the current step (if it is sampled)
+    std::chrono::steady_clock::time_point  fStartTime;
+
+    /// info whether the start time of the current step was recorded
+    G4bool  fHasStartTime;
+
+    /// counters indexed by logical volume instance ID
+    std::vector<Counter>  fVolumeCounters;
+
+    /// counters per particle definition
+    /// (not indexed by the definition ID which is shared by all general ions)
+    std::unordered_map<const G4ParticleDefinition*, Counter>  fParticleCounters;
+
+    /// counters per process
+    std::unordered_map<const G4VProcess*, Counter>  fProcessCounters;
+};
+
+// inline methods
+
+inline void TG4StepProfiler::SetIsActive(G4bool isActive) {
+  /// (In)Activate the step profiling
+  fgIsActive = isActive;
+}
+
+inline void TG4StepProfiler::SetNofTop(G4int nofTop) {
+  /// Set the number of entries printed in the report
+  fgNofTop = nofTop;
+}
+
+inline void TG4StepProfiler::SetOutputFileName(const G4String& fileName) {
+  /// Set the CSV output file name (no output if empty)
+  fgOutputFileName = fileName;
+}
+
+inline G4bool TG4StepProfiler::IsActive() {
+  /// Return true if the step profiling is activated
+  return fgIsActive;
+}
+
+inline const TG4StepProfiler::CounterMap& 
+TG4StepProfiler::GetVolumeCounters() {
+  /// Return the merged counters per logical volume name
+  return fgVolumeCounters;
+}
+
+inline const TG4StepProfiler::CounterMap& 
+TG4StepProfiler::GetParticleCounters() {
+  /// Return the merged counters per particle name
+  return fgParticleCounters;
+}
+
+inline const TG4StepProfiler::CounterMap& 
+TG4StepProfiler::GetProcessCounters() {
+  /// Return the merged counters per process name
+  return fgProcessCounters;
+}
+
+#endif //TG4_STEP_PROFILER_H
+
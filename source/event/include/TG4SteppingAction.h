@@ -17,6 +17,7 @@
 
 #include "TG4SteppingActionMessenger.h"
 #include "TG4GeoTrackManager.h"
+#include "TG4StepProfiler.h"
 
 #include <G4UserSteppingAction.hh>
 
@@ -76,6 +77,8 @@ class TG4SteppingAction : public G4UserSteppingAction
     G4int GetMaxNofSteps() const;
     G4bool GetIsPairCut() const;
     G4bool GetCollectTracks() const;
+    TG4StepProfiler& GetStepProfiler();
+    TG4GeoTrackManager& GetGeoTrackManager();
 
   protected:
     // methods
@@ -105,6 +108,9 @@ class TG4SteppingAction : public G4UserSteppingAction
     /// manager for collecting TGeo tracks    
     TG4GeoTrackManager  fGeoTrackManager;
 
+    /// the stepping profiler
+    TG4StepProfiler  fStepProfiler;
+
     /// the special controls manager
     TG4SpecialControlsV2*  fSpecialControls;
 
@@ -196,4 +202,14 @@ inline G4bool TG4SteppingAction::GetCollectTracks() const {
   return fCollectTracks;
 }  
 
+inline TG4StepProfiler& TG4SteppingAction::GetStepProfiler() {
+  /// Return the stepping profiler
+  return fStepProfiler;
+}  
+
+inline TG4GeoTrackManager& TG4SteppingAction::GetGeoTrackManager() {
+  /// Return the manager for collecting TGeo tracks
+  return fGeoTrackManager;
+}  
+
 #endif //TG4_STEPPING_ACTION_H
@@ -17,6 +17,7 @@
 
 #include "TG4Verbose.h"
 #include "TG4TrackSaveControl.h"
+#include "TG4TrackSavePolicy.h"
 
 #include <G4UserTrackingAction.hh>
 #include <G4TrackVector.hh>
@@ -25,6 +26,7 @@ class TG4TrackInformation;
 class TG4StackPopper;
 
 class TVirtualMCStack;
+class TVirtualMCStackWithKeepFlag;
 
 class G4Track;
 class G4PrimaryVertex;
@@ -38,6 +40,16 @@ class G4PrimaryParticle;
 /// TG4TrackInformation, which hold the info about
 /// correspondence between Geant4 and VMC stack numbering 
 ///
+/// If the overwriting of tracks is activated and the VMC stack implements
+/// the TVirtualMCStackWithKeepFlag interface, the secondary track saved 
+/// in pre-track can overwrite the last track in the stack, if this track 
+/// has finished, has not produced secondaries and was not flagged to be kept 
+/// (see TG4TrackingAction::PostUserTrackingAction()).
+///
+/// The secondary tracks which are not selected by the track save policy 
+/// (if active) are not saved in the VMC stack; they take over the stack 
+/// index of their nearest saved ancestor.
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 class TG4TrackManager : public TG4Verbose 
@@ -56,16 +68,20 @@ class TG4TrackManager : public TG4Verbose
     void  SetParentToTrackInformation(const G4Track* aTrack);
     void  SetBackPDGLifetime(const G4Track* aTrack);
 
-    void  TrackToStack(const G4Track* track, G4bool overWrite = false);
+    void  TrackToStack(const G4Track* track, G4bool overWrite = false,
+                       G4bool atVertex = false);
     void  PrimaryToStack(const G4PrimaryVertex* vertex,
                        const G4PrimaryParticle* particle);
 
     void  SaveSecondaries(const G4Track* track, const G4TrackVector* secondaries);
+    G4int DropTrack(const G4Track* track);
+    void  SaveDroppedTrack(const G4Track* track);
 
     // set methods
     void SetMCStack(TVirtualMCStack*  mcStack);
     void SetTrackSaveControl(TG4TrackSaveControl control);
     void SetSaveDynamicCharge(G4bool saveDynamicCharge);
+    void SetOverwriteTracks(G4bool overwriteTracks);
     void SetNofTracks(G4int nofTracks);
     void SetG4TrackingManager(G4TrackingManager* trackingManager);
     void ResetPrimaryParticleIds();
@@ -74,8 +90,12 @@ class TG4TrackManager : public TG4Verbose
     TG4TrackInformation* GetTrackInformation(const G4Track* track) const;
     TG4TrackSaveControl  GetTrackSaveControl() const;
     G4bool GetSaveDynamicCharge() const;
+    G4bool GetOverwriteTracks() const;
+    G4bool IsOverwriteTracks() const;
+    TVirtualMCStackWithKeepFlag* GetKeepFlagMCStack() const;
     G4int  GetNofTracks() const;
     G4bool IsUserTrack(const G4Track* track) const;
+    TG4TrackSavePolicy& GetTrackSavePolicy();
 
   private:
     /// Not implemented
@@ -83,6 +103,9 @@ class TG4TrackManager : public TG4Verbose
     /// Not implemented
     TG4TrackManager& operator=(const TG4TrackManager& right);
 
+    // methods
+    void CheckOverwriteTracks() const;
+
     // static data members
     static G4ThreadLocal TG4TrackManager*   fgInstance; ///< this instance
 
@@ -94,10 +117,18 @@ class TG4TrackManager : public TG4Verbose
     /// Cached pointer to thread-local VMC stack
     TVirtualMCStack*  fMCStack;
 
+    /// Cached pointer to thread-local VMC stack keep flag interface 
+    /// (if implemented)
+    TVirtualMCStackWithKeepFlag*  fKeepFlagMCStack;
+
+    /// The policy for selecting the saved secondaries
+    TG4TrackSavePolicy  fTrackSavePolicy;
+
     /// Cached pointer to thread-local stack popper
     TG4StackPopper* fStackPopper;
 
     G4bool  fSaveDynamicCharge;     ///< control of saving dynamic charge of secondaries
+    G4bool  fOverwriteTracks;       ///< control of overwriting tracks in the stack
     G4int   fTrackCounter;          ///< tracks counter
     G4int   fCurrentTrackID;        ///< current track ID
     G4int   fNofSavedSecondaries;   ///< number of secondaries already saved
@@ -111,11 +142,6 @@ inline TG4TrackManager* TG4TrackManager::Instance() {
   return fgInstance; 
 }
 
-inline void TG4TrackManager::SetMCStack(TVirtualMCStack* mcStack) {
-  /// Set  cached pointer to thread-local VMC stack
-  fMCStack = mcStack;
-}
-
 inline void TG4TrackManager::SetTrackSaveControl(TG4TrackSaveControl control) { 
   /// Set control for saving secondaries in the VMC stack
   fTrackSaveControl = control;
@@ -149,6 +175,31 @@ inline G4bool  TG4TrackManager::GetSaveDynamicCharge() const
   return fSaveDynamicCharge; 
 }  
 
+inline TG4TrackSavePolicy& TG4TrackManager::GetTrackSavePolicy() {
+  /// Return the policy for selecting the saved secondaries
+  return fTrackSavePolicy;
+}
+
+inline G4bool  TG4TrackManager::GetOverwriteTracks() const
+{
+  /// Return the control of overwriting tracks in the stack
+  return fOverwriteTracks; 
+}  
+
+inline G4bool  TG4TrackManager::IsOverwriteTracks() const
+{
+  /// Return true if the overwriting of tracks is activated
+  /// and it is supported by the VMC stack
+  return fOverwriteTracks && fKeepFlagMCStack; 
+}  
+
+inline TVirtualMCStackWithKeepFlag* TG4TrackManager::GetKeepFlagMCStack() const
+{
+  /// Return the VMC stack keep flag interface if it is implemented,
+  /// 0 otherwise
+  return fKeepFlagMCStack; 
+}  
+
 inline G4int TG4TrackManager::GetNofTracks() const { 
   /// Return track counter = current number of tracks (in event)  
   return fTrackCounter; 
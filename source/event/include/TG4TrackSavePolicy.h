@@ -0,0 +1,114 @@
+#ifndef TG4_TRACK_SAVE_POLICY_H
+#define TG4_TRACK_SAVE_POLICY_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4TrackSavePolicy.h
+/// \brief Definition of the TG4TrackSavePolicy class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4TrackSavePolicyMessenger.h"
+
+#include <globals.hh>
+
+#include <set>
+
+class TG4VTrackSelection;
+
+class G4Track;
+class G4Region;
+
+/// \ingroup event
+/// \brief The policy for selecting the secondary tracks saved in the VMC stack
+///
+/// When the policy is active, the secondary tracks are saved in the VMC 
+/// stack only if they are selected. A track is selected at its vertex 
+/// if it passes all defined criteria:
+/// - the kinetic energy is above the threshold;
+/// - the creator process is in the list of processes;
+/// - the vertex volume medium is in the list of media;
+/// - the vertex volume region is in the list of regions;
+/// - the user selection (TG4VTrackSelection) accepts it.
+///
+/// Optionally, a track which was not selected is saved later if it makes 
+/// a step in a sensitive detector (the save-on-SD-hit option).
+///
+/// The tracks which are not saved take over the stack index of their nearest 
+/// saved ancestor, so that their secondaries and the hits they produce 
+/// are attributed to this ancestor and the saved tracks tree stays consistent.
+///
+/// The policy applies to both kSaveInPreTrack and kSaveInStep modes of 
+/// TG4TrackSaveControl. In kSaveInStep mode, the secondaries saved before 
+/// their parent was saved on SD hit are linked to its saved ancestor. 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4TrackSavePolicy
+{
+  public:
+    TG4TrackSavePolicy();
+    ~TG4TrackSavePolicy();
+
+    // methods
+    G4bool Select(const G4Track* track);
+    void   Print() const;
+    void   Reset();
+
+    // set methods
+    void SetMinEkin(G4double minEkin);
+    void AddProcess(const G4String& processName);
+    void AddMedium(const G4String& mediumName);
+    void AddRegion(const G4String& regionName);
+    void SetSaveOnSDHit(G4bool saveOnSDHit);
+    void SetSelection(TG4VTrackSelection* selection);
+
+    // get methods
+    G4bool IsActive() const;
+    G4bool IsSaveOnSDHit() const;
+
+  private:
+    /// Not implemented
+    TG4TrackSavePolicy(const TG4TrackSavePolicy& right);
+    /// Not implemented
+    TG4TrackSavePolicy& operator=(const TG4TrackSavePolicy& right);
+
+    // methods
+    void Resolve();
+    void UpdateHasCriteria();
+
+    // data members
+    TG4TrackSavePolicyMessenger  fMessenger; ///< messenger
+    G4double  fMinEkin;                  ///< the kinetic energy threshold
+    std::set<G4String>  fProcessNames;   ///< the selected process names
+    std::set<G4String>  fMediumNames;    ///< the selected medium names
+    std::set<G4String>  fRegionNames;    ///< the selected region names
+    std::set<G4int>     fMediumIds;      ///< the selected medium IDs
+    std::set<const G4Region*>  fRegions; ///< the selected regions
+    TG4VTrackSelection*  fSelection;     ///< the user selection
+    G4bool    fSaveOnSDHit; ///< option to save not selected tracks on SD hit
+    G4bool    fHasCriteria; ///< info whether any selection criterion is set
+    G4bool    fIsResolved;  ///< info whether media and regions were resolved
+};
+
+// inline methods
+
+inline G4bool TG4TrackSavePolicy::IsActive() const {
+  /// Return true if the policy is active
+  return fHasCriteria || fSaveOnSDHit;
+}
+
+inline G4bool TG4TrackSavePolicy::IsSaveOnSDHit() const {
+  /// Return the option to save not selected tracks on SD hit
+  return fSaveOnSDHit;
+}
+
+#endif //TG4_TRACK_SAVE_POLICY_H
+
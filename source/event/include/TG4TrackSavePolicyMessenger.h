@@ -0,0 +1,73 @@
+#ifndef TG4_TRACK_SAVE_POLICY_MESSENGER_H
+#define TG4_TRACK_SAVE_POLICY_MESSENGER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4TrackSavePolicyMessenger.h
+/// \brief Definition of the TG4TrackSavePolicyMessenger class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class TG4TrackSavePolicy;
+
+class G4UIdirectory;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithoutParameter;
+
+/// \ingroup event
+/// \brief Messenger class that defines commands for TG4TrackSavePolicy.
+///
+/// Implements commands
+/// - /mcTracking/savePolicy/minEkin [value] [unit]
+/// - /mcTracking/savePolicy/addProcess [processName]
+/// - /mcTracking/savePolicy/addMedium [mediumName]
+/// - /mcTracking/savePolicy/addRegion [regionName]
+/// - /mcTracking/savePolicy/saveOnSDHit [true|false]
+/// - /mcTracking/savePolicy/reset
+/// - /mcTracking/savePolicy/print
+/// 
+/// \author I. Hrivnacova; IPN, Orsay
+ 
+class TG4TrackSavePolicyMessenger: public G4UImessenger
+{
+  public:
+    TG4TrackSavePolicyMessenger(TG4TrackSavePolicy* savePolicy);
+    virtual ~TG4TrackSavePolicyMessenger();
+   
+    // methods 
+    virtual void SetNewValue(G4UIcommand* command, G4String string);
+    
+  private:
+    /// Not implemented
+    TG4TrackSavePolicyMessenger();
+    /// Not implemented
+    TG4TrackSavePolicyMessenger(const TG4TrackSavePolicyMessenger& right);
+    /// Not implemented
+    TG4TrackSavePolicyMessenger& operator=(
+                               const TG4TrackSavePolicyMessenger& right);
+
+    // data members
+    TG4TrackSavePolicy*         fSavePolicy;     ///< associated class 
+    G4UIdirectory*              fDirectory;      ///< command directory
+    G4UIcmdWithADoubleAndUnit*  fMinEkinCmd;     ///< command: minEkin
+    G4UIcmdWithAString*         fAddProcessCmd;  ///< command: addProcess
+    G4UIcmdWithAString*         fAddMediumCmd;   ///< command: addMedium
+    G4UIcmdWithAString*         fAddRegionCmd;   ///< command: addRegion
+    G4UIcmdWithABool*           fSaveOnSDHitCmd; ///< command: saveOnSDHit
+    G4UIcmdWithoutParameter*    fResetCmd;       ///< command: reset
+    G4UIcmdWithoutParameter*    fPrintCmd;       ///< command: print
+};
+
+#endif //TG4_TRACK_SAVE_POLICY_MESSENGER_H
@@ -25,6 +25,7 @@ class TG4TrackInformation;
 class TG4TrackManager;
 class TG4StepManager;
 class TG4StackPopper;
+class TG4StepProfiler;
 class TG4SpecialControlsV2;
 
 class TVirtualMCApplication;
@@ -111,6 +112,9 @@ class TG4TrackingAction : public G4UserTrackingAction,
     /// Cached pointer to thread-local stack popper
     TG4StackPopper* fStackPopper;
 
+    /// Cached pointer to thread-local step profiler
+    TG4StepProfiler* fStepProfiler;
+
     /// current primary track ID 
     G4int   fPrimaryTrackID;
     
@@ -120,7 +124,8 @@ class TG4TrackingAction : public G4UserTrackingAction,
     /// control of saving secondary tracks
     TG4TrackSaveControl  fTrackSaveControl;
 
-    /// control of saving current track
+    /// info whether the last track in the stack can be overwritten
+    /// by the next track
     G4bool  fOverwriteLastTrack;
 
     /// new /tracking/verbose level
@@ -33,6 +33,8 @@ class G4UIcmdWithABool;
 /// - /mcTracking/newVerboseTrack [trackID]
 /// - /mcTracking/saveSecondaries [DoNotSave|SaveInPreTrack|SaveInStep]
 /// - /mcTracking/saveDynamicCharge [true|false]
+/// - /mcTracking/overwriteTracks [true|false]
+/// - /mcTracking/trackInfoPageFactor [factor]
 /// 
 /// \author I. Hrivnacova; IPN, Orsay
  
@@ -61,6 +63,8 @@ class TG4TrackingActionMessenger: public G4UImessenger
     G4UIcmdWithAnInteger*  fNewVerboseTrackCmd;///< command: newVerboseTrack
     G4UIcmdWithAString*    fSaveSecondariesCmd;///< command: saveSecondaries
     G4UIcmdWithABool*      fSaveDynamicChargeCmd; ///< command: saveDynamicCharge
+    G4UIcmdWithABool*      fOverwriteTracksCmd;   ///< command: overwriteTracks
+    G4UIcmdWithAnInteger*  fTrackInfoPageFactorCmd; ///< command: trackInfoPageFactor
 };
 
 #endif //TG4_TRACKING_ACTION_MESSENGER_H
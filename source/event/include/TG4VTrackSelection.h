@@ -0,0 +1,51 @@
+#ifndef TG4_V_TRACK_SELECTION_H
+#define TG4_V_TRACK_SELECTION_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4VTrackSelection.h
+/// \brief Definition of the TG4VTrackSelection class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <globals.hh>
+
+class G4Track;
+
+/// \ingroup event
+/// \brief The interface for a user selection of secondary tracks 
+/// to be saved in the VMC stack
+///
+/// The user selection can be added to the track save policy via 
+/// TG4TrackSavePolicy::SetSelection(); it is then evaluated for each
+/// secondary track, at its vertex, after the policy criteria.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4VTrackSelection
+{
+  public:
+    TG4VTrackSelection();
+    virtual ~TG4VTrackSelection();
+
+    // methods
+
+    /// Return true if the track should be saved in the VMC stack
+    virtual G4bool Select(const G4Track* track) const = 0;
+
+  private:
+    /// Not implemented
+    TG4VTrackSelection(const TG4VTrackSelection& right);
+    /// Not implemented
+    TG4VTrackSelection& operator=(const TG4VTrackSelection& right);
+};
+
+#endif //TG4_V_TRACK_SELECTION_H
+
@@ -14,10 +14,14 @@
 
 #include "TG4EventAction.h"
 #include "TG4TrackingAction.h"
+#include "TG4SteppingAction.h"
 #include "TG4ParticlesManager.h"
 #include "TG4TrackManager.h"
+#include "TG4TrackInformation.h"
 #include "TG4StateManager.h"
+#include "TG4StackPopper.h"
 #include "TG4SDServices.h"
+#include "TG4CallbackTimer.h"
 #include "TG4Globals.h"
 
 #include <G4Event.hh>
@@ -31,7 +35,6 @@
 #include <TVirtualMCStack.h>
 #include <TVirtualMCApplication.h>
 #include <TVirtualMCSensitiveDetector.h>
-#include <TSystem.h>
 
 #include <math.h>
 
@@ -40,6 +43,7 @@ TG4EventAction::TG4EventAction()
   : TG4Verbose("eventAction"),
     fMessenger(this),
     fTimer(),
+    fMemoryStatistics(),
     fMCApplication(0),
     fMCStack(0),
     fTrackingAction(0),
@@ -79,6 +83,12 @@ void TG4EventAction::BeginOfEventAction(const G4Event* event)
 
   // reset the tracks counters
   fTrackingAction->PrepareNewEvent();
+
+  // reset the tracks recorded for TGeo visualization
+  TG4SteppingAction::Instance()->GetGeoTrackManager().Reset();
+
+  // reset the memory accounting per event
+  if ( fPrintMemory ) fMemoryStatistics.BeginOfEvent();
     
   // fill primary particles in VMC stack if stack is empty
   if ( fMCStack->GetNtrack() == 0 ) {
@@ -135,17 +145,35 @@ void TG4EventAction::EndOfEventAction(const G4Event* event)
     G4int nofAllTracks = fTrackManager->GetNofTracks();
     G4cout  << "    " << nofAllTracks << 
                   " all tracks processed." << G4endl;
+
+    if ( TG4StackPopper::Instance() ) {
+      G4cout  << "    " << TG4StackPopper::Instance()->GetNofPoppedTracks() << 
+                 " tracks injected by stack popper." << G4endl;
+    }
   }
 
   // User SDs finish event
   if ( TG4SDServices::Instance()->GetUserSDs() ) {
     for (auto& userSD : (*TG4SDServices::Instance()->GetUserSDs()) ) {
+#ifdef USE_CALLBACK_TIMING
+      TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kSDEndOfEvent);
+#endif
       userSD->EndOfEvent();
     }
   }
 
+  // Fill TGeo tracks from the recorded track points
+  if ( TG4SteppingAction::Instance()->GetCollectTracks() ) {
+    TG4SteppingAction::Instance()->GetGeoTrackManager().FillGeoTracks();
+  }
+
   // VMC application finish event
-  fMCApplication->FinishEvent();
+  {
+#ifdef USE_CALLBACK_TIMING
+    TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kFinishEvent);
+#endif
+    fMCApplication->FinishEvent();
+  }
   fStateManager->SetNewState(kNotInApplication);
 
   if (VerboseLevel() > 1) {
@@ -155,9 +183,8 @@ void TG4EventAction::EndOfEventAction(const G4Event* event)
   }  
 
   if ( fPrintMemory ) {
-    ProcInfo_t procInfo;
-    gSystem->GetProcInfo(&procInfo);
-    G4cout << "Current memory usage: resident " 
-           << procInfo.fMemResident << ", virtual " << procInfo.fMemVirtual << G4endl;
+    fMemoryStatistics.EndOfEvent(event, fMCStack);
+    fMemoryStatistics.Print(event->GetEventID());
+    TG4TrackInformation::PrintAllocatorStatistics();
   }         
 }
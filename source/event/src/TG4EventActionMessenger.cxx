@@ -34,6 +34,8 @@ TG4EventActionMessenger::TG4EventActionMessenger(TG4EventAction* eventAction)
 
   fPrintMemoryCmd = new G4UIcmdWithABool("/mcEvent/printMemory", this);
   fPrintMemoryCmd->SetGuidance("Print memory usage at the end of event");
+  fPrintMemoryCmd->SetGuidance("(per track and stack objects, with high-water marks");
+  fPrintMemoryCmd->SetGuidance("reported also at the end of run)");
   fPrintMemoryCmd->SetParameterName("PrintMemory", false);
   fPrintMemoryCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
 
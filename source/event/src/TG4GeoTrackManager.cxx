@@ -13,25 +13,39 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include "TG4GeoTrackManager.h"
+#include "TG4ParticlesManager.h"
+#include "TG4G3Units.h"
 #include "TG4Globals.h"
 
+#include <G4Step.hh>
 #include <G4Track.hh>
 
 #include <TVirtualMC.h>
+#include <TVirtualMCStack.h>
 #include <TGeoManager.h>
 #include <TVirtualGeoTrack.h>
 #include <TParticlePDG.h>
 #include <TDatabasePDG.h>
 
+#include <cmath>
+
 // static data members
 const G4double  TG4GeoTrackManager::fgkMinPointDistance = 0.01; 
 
 //_____________________________________________________________________________
 TG4GeoTrackManager::TG4GeoTrackManager() 
   : TG4Verbose("geoTrackManager"),
-    fCollectTracks(kFALSE),
-    fCurrentTGeoTrack(0),
-    fParentTGeoTrack(0)
+    fMessenger(this),
+    fMinPointDistance2(fgkMinPointDistance*fgkMinPointDistance),
+    fCosMinAngle(1.),
+    fMaxNofPoints(0),
+    fMaxNofEventPoints(0),
+    fTrackRecords(),
+    fTrackIndices(),
+    fCurrentIndex(-1),
+    fCurrentG4TrackID(0),
+    fNofPoints(0),
+    fIsMemoryExhausted(false)
 {
 /// Default constructor
 }
@@ -42,6 +56,96 @@ TG4GeoTrackManager::~TG4GeoTrackManager()
 /// Destructor
 }
 
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4GeoTrackManager::SetCurrentTrack(const G4Track* track)
+{
+/// Find the record for the given track or create a new one
+/// if the track is processed for the first time
+
+  fCurrentG4TrackID = track->GetTrackID();
+
+  // The records are indexed by G4 track ID, as the VMC track number
+  // needs not be unique when tracks are dropped or overwritten in the stack
+  std::unordered_map<G4int, G4int>::const_iterator it 
+    = fTrackIndices.find(fCurrentG4TrackID);
+  if ( it != fTrackIndices.end() ) {
+    // the track was suspended
+    fCurrentIndex = it->second;
+    return;
+  }
+
+  TrackRecord record;
+  record.fTrackId = gMC->GetStack()->GetCurrentTrackNumber();
+  record.fParentId = gMC->GetStack()->GetCurrentParentTrackNumber();
+  record.fG4ParentId = track->GetParentID();
+  record.fPdg = TG4ParticlesManager::Instance()
+                  ->GetPDGEncoding(track->GetDefinition());
+  record.fIsTruncated = false;
+
+  fCurrentIndex = fTrackRecords.size();
+  fTrackRecords.push_back(record);
+  fTrackIndices[fCurrentG4TrackID] = fCurrentIndex;
+
+  if ( VerboseLevel() > 1 ) {
+    G4cout << "New recorded track with id=" << record.fTrackId
+           << "  pdg=" << record.fPdg
+           << "  parent=" << record.fParentId << G4endl;
+  }         
+}
+
+//_____________________________________________________________________________
+void TG4GeoTrackManager::AddPoint(TrackRecord& record, 
+                                  const G4StepPoint* point)
+{
+/// Add the given step point to the track record.
+/// If the per track or per event limit is reached, the last recorded point
+/// of the track is replaced, so that the track end point is always kept.
+
+  G4bool replaceLast = false;
+  if ( fMaxNofPoints > 0 && G4int(record.fPoints.size()) >= fMaxNofPoints ) {
+    replaceLast = true;
+    record.fIsTruncated = true;
+  }
+  else if ( fMaxNofEventPoints > 0 && fNofPoints >= fMaxNofEventPoints ) {
+    if ( ! fIsMemoryExhausted ) {
+      TG4Globals::Warning(
+        "TG4GeoTrackManager", "AddPoint",
+        "The memory budget for track points was reached." + TG4Globals::Endl() +
+        "Only the end points will be updated for the rest of the event.");
+      fIsMemoryExhausted = true;
+    }
+    if ( record.fPoints.empty() ) return;
+    replaceLast = true;
+    record.fIsTruncated = true;
+  }
+
+  const G4ThreeVector& position = point->GetPosition();
+  TrackPoint trackPoint;
+  trackPoint.fX = position.x()/TG4G3Units::Length();
+  trackPoint.fY = position.y()/TG4G3Units::Length();
+  trackPoint.fZ = position.z()/TG4G3Units::Length();
+  trackPoint.fT = point->GetGlobalTime()/TG4G3Units::Time();
+
+  if ( replaceLast ) {
+    record.fPoints.back() = trackPoint;
+  }
+  else {
+    record.fPoints.push_back(trackPoint);
+    ++fNofPoints;
+  }
+  record.fLastDirection = point->GetMomentumDirection();
+
+  if ( VerboseLevel() > 2 ) {
+    G4cout << "Added point (x,y,z,t)=" 
+           << trackPoint.fX << ", " << trackPoint.fY << ", " 
+           << trackPoint.fZ << ", " << trackPoint.fT << G4endl;
+  }         
+}
+
 //
 // public methods
 //
@@ -49,67 +153,150 @@ TG4GeoTrackManager::~TG4GeoTrackManager()
 //_____________________________________________________________________________
 void TG4GeoTrackManager::UpdateRootTrack(const G4Step* step)
 {
-/// Update the TGeo track with a current step point
-
-   G4Track* track = step->GetTrack();  
-   G4int stepNumber = track->GetCurrentStepNumber();
-   
-   if ( stepNumber == 1 ) {
-     // Find and update parent track if it exists
-     Int_t trackNumber 
-       = gMC->GetStack()->GetCurrentTrackNumber();
-     Int_t parentTrackNumber 
-       = gMC->GetStack()->GetCurrentParentTrackNumber(); 
-     Int_t pdg = gMC->TrackPid();
-     if ( parentTrackNumber >= 0 ) {
-       fParentTGeoTrack = gGeoManager->FindTrackWithId(parentTrackNumber);
-       if ( ! fParentTGeoTrack ) {
-         TString text = "No parent track with id=";
-         text += parentTrackNumber;
-         TG4Globals::Exception("TG4GeoTrackManager", "UpdateRootTrack", text);
-       } 
-       fCurrentTGeoTrack = fParentTGeoTrack->AddDaughter(trackNumber, pdg);
-       gGeoManager->SetCurrentTrack(fCurrentTGeoTrack);
-       
-       if ( VerboseLevel() > 1 ) {
-         G4cout << "New TGeo track with id=" << trackNumber
-                << "  pdg=" << pdg
-                << "  parent=" << parentTrackNumber << G4endl;
-       }         
-     }
-     else {
-       Int_t itrack = gGeoManager->AddTrack(trackNumber, pdg);
-       gGeoManager->SetCurrentTrack(itrack);
-       fCurrentTGeoTrack = gGeoManager->GetCurrentTrack();
-       if ( VerboseLevel() > 1 ) {
-         G4cout << "New primary TGeo track with id=" << trackNumber
-                << "  pdg=" << pdg << G4endl;
-       }         
-     }  
-     TParticlePDG* particle = TDatabasePDG::Instance()->GetParticle(pdg);
-     if ( particle ) {
-       fCurrentTGeoTrack->SetName(particle->GetName());
-       fCurrentTGeoTrack->SetParticle(particle);
-     }
-   }
-
-   // Skip point if its distance from the previous one is smaller than the limit
-   Double_t x, y, z;
-   gMC->TrackPosition(x, y, z);
-   Bool_t skipPoint = kFALSE;
-   if ( fCurrentTGeoTrack->HasPoints() ) {
-      Double_t xo,yo,zo,to;
-      fCurrentTGeoTrack->GetLastPoint(xo,yo,zo,to);
-      Double_t rdist = TMath::Sqrt((xo-x)*(xo-x)+(yo-y)*(yo-y)+(zo-z)*(zo-z));
-      if ( rdist < fgkMinPointDistance ) skipPoint=kTRUE;
-   }
-   if ( skipPoint ) return;
-   
-   // Add point to the track
-   G4double time = gMC->TrackTime();
-   fCurrentTGeoTrack->AddPoint(x, y, z, time);
-   if ( VerboseLevel() > 2 ) {
-     G4cout << "Added point (x,y,z,t)=" 
-            << x << ", " << y << ", " << z << ", " << time << G4endl;
-   }         
+/// Record the current step point if it passes the distance and angle
+/// selection; the track end point is always recorded
+
+  G4Track* track = step->GetTrack();  
+  if ( track->GetTrackID() != fCurrentG4TrackID || fCurrentIndex < 0 ) {
+    SetCurrentTrack(track);
+  }
+  TrackRecord& record = fTrackRecords[fCurrentIndex];
+
+  // Record the track vertex
+  if ( record.fPoints.empty() ) {
+    AddPoint(record, step->GetPreStepPoint());
+    if ( record.fPoints.empty() ) return;
+  }
+
+  const G4StepPoint* postStepPoint = step->GetPostStepPoint();
+  if ( track->GetTrackStatus() == fAlive ) {
+    // Skip point if its distance from the previous one is smaller 
+    // than the limit
+    const TrackPoint& lastPoint = record.fPoints.back();
+    const G4ThreeVector& position = postStepPoint->GetPosition();
+    G4double dx = position.x()/TG4G3Units::Length() - lastPoint.fX;
+    G4double dy = position.y()/TG4G3Units::Length() - lastPoint.fY;
+    G4double dz = position.z()/TG4G3Units::Length() - lastPoint.fZ;
+    if ( dx*dx + dy*dy + dz*dz < fMinPointDistance2 ) return;
+
+    // Skip point if the track direction did not change enough
+    if ( fCosMinAngle < 1. &&
+         record.fLastDirection.dot(postStepPoint->GetMomentumDirection()) 
+           > fCosMinAngle ) return;
+  }
+
+  AddPoint(record, postStepPoint);
+}
+
+//_____________________________________________________________________________
+void TG4GeoTrackManager::FillGeoTracks()
+{
+/// Convert the recorded tracks in TGeo tracks and reset the buffers
+
+  if ( ! gGeoManager ) {
+    TG4Globals::Warning(
+      "TG4GeoTrackManager", "FillGeoTracks", "No TGeo manager is defined.");
+    Reset();
+    return;
+  }
+
+  std::vector<TVirtualGeoTrack*> geoTracks(fTrackRecords.size(), 0);
+  for ( size_t i=0; i<fTrackRecords.size(); ++i ) {
+    const TrackRecord& record = fTrackRecords[i];
+
+    // Skip tracks without points (recorded after the memory budget 
+    // was reached); their daughters are added as primaries
+    if ( record.fPoints.empty() ) continue;
+
+    // Find parent track; as the parent starts tracking before its daughters, 
+    // it is always recorded before them
+    TVirtualGeoTrack* parentTrack = 0;
+    if ( record.fG4ParentId > 0 ) {
+      std::unordered_map<G4int, G4int>::const_iterator it
+        = fTrackIndices.find(record.fG4ParentId);
+      if ( it != fTrackIndices.end() ) parentTrack = geoTracks[it->second];
+
+      if ( ! parentTrack && VerboseLevel() > 1 ) {
+        G4cout << "Parent track with id=" << record.fParentId 
+               << " was not recorded; track with id=" << record.fTrackId
+               << " is added as a primary." << G4endl;
+      }         
+    }
+
+    TVirtualGeoTrack* geoTrack = 0;
+    if ( parentTrack ) {
+      geoTrack = parentTrack->AddDaughter(record.fTrackId, record.fPdg);
+    }
+    else {
+      Int_t index = gGeoManager->AddTrack(record.fTrackId, record.fPdg);
+      geoTrack = gGeoManager->GetTrack(index);
+    }
+    geoTracks[i] = geoTrack;
+
+    TParticlePDG* particle = TDatabasePDG::Instance()->GetParticle(record.fPdg);
+    if ( particle ) {
+      geoTrack->SetName(particle->GetName());
+      geoTrack->SetParticle(particle);
+    }
+
+    for ( size_t j=0; j<record.fPoints.size(); ++j ) {
+      const TrackPoint& point = record.fPoints[j];
+      geoTrack->AddPoint(point.fX, point.fY, point.fZ, point.fT);
+    }
+  }
+
+  if ( VerboseLevel() > 0 ) {
+    G4cout << "Filled " << fTrackRecords.size() << " TGeo tracks with " 
+           << fNofPoints << " points." << G4endl;
+  }         
+
+  Reset();
+}
+
+//_____________________________________________________________________________
+void TG4GeoTrackManager::Reset()
+{
+/// Clear the recorded tracks
+
+  fTrackRecords.clear();
+  fTrackIndices.clear();
+  fCurrentIndex = -1;
+  fCurrentG4TrackID = 0;
+  fNofPoints = 0;
+  fIsMemoryExhausted = false;
+}
+
+//_____________________________________________________________________________
+void TG4GeoTrackManager::SetMinPointDistance(G4double distance)
+{
+/// Set the minimum distance between two recorded points
+/// (the distance is given in G4 units)
+
+  G4double distanceG3 = distance/TG4G3Units::Length();
+  fMinPointDistance2 = distanceG3*distanceG3;
+}
+
+//_____________________________________________________________________________
+void TG4GeoTrackManager::SetMinAngle(G4double angle)
+{
+/// Set the minimum change of the track direction since the last recorded
+/// point needed to record a new point (0 switches the selection off)
+
+  fCosMinAngle = ( angle > 0. ) ? std::cos(angle) : 1.;
+}
+
+//_____________________________________________________________________________
+void TG4GeoTrackManager::SetMaxNofPoints(G4int maxNofPoints)
+{
+/// Set the maximum number of recorded points per track (0 = no limit)
+
+  fMaxNofPoints = maxNofPoints;
+}
+
+//_____________________________________________________________________________
+void TG4GeoTrackManager::SetMaxMemory(G4int megaBytes)
+{
+/// Set the memory budget for recorded points per event (0 = no limit)
+
+  fMaxNofEventPoints = size_t(megaBytes)*1024*1024/sizeof(TrackPoint);
 }
@@ -0,0 +1,116 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4GeoTrackManagerMessenger.cxx
+/// \brief Implementation of the TG4GeoTrackManagerMessenger class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4GeoTrackManagerMessenger.h"
+#include "TG4GeoTrackManager.h"
+
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithADoubleAndUnit.hh>
+#include <G4UIcmdWithAnInteger.hh>
+
+//_____________________________________________________________________________
+TG4GeoTrackManagerMessenger::TG4GeoTrackManagerMessenger(
+                               TG4GeoTrackManager* geoTrackManager)
+  : G4UImessenger(),
+    fGeoTrackManager(geoTrackManager),
+    fDirectory(0),
+    fMinPointDistanceCmd(0),
+    fMinAngleCmd(0),
+    fMaxNofPointsCmd(0),
+    fMaxMemoryCmd(0)
+{
+/// Standard constructor
+
+  fDirectory = new G4UIdirectory("/mcTracking/geoTracks/");
+  fDirectory->SetGuidance("Control of recording tracks for TGeo visualization");
+  fDirectory->SetGuidance("(activated with TVirtualMC::SetCollectTracks()).");
+
+  fMinPointDistanceCmd 
+    = new G4UIcmdWithADoubleAndUnit("/mcTracking/geoTracks/minPointDistance", this);
+  fMinPointDistanceCmd
+    ->SetGuidance("Set the minimum distance between two recorded track points.");
+  fMinPointDistanceCmd->SetParameterName("MinPointDistance", false);
+  fMinPointDistanceCmd->SetDefaultUnit("cm");
+  fMinPointDistanceCmd->SetRange("MinPointDistance >= 0.");
+  fMinPointDistanceCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fMinAngleCmd 
+    = new G4UIcmdWithADoubleAndUnit("/mcTracking/geoTracks/minAngle", this);
+  fMinAngleCmd
+    ->SetGuidance("Set the minimum change of the track direction since the last");
+  fMinAngleCmd->SetGuidance("recorded point required to record a new point;");
+  fMinAngleCmd->SetGuidance("0 switches the angle selection off.");
+  fMinAngleCmd->SetParameterName("MinAngle", false);
+  fMinAngleCmd->SetDefaultUnit("deg");
+  fMinAngleCmd->SetRange("MinAngle >= 0.");
+  fMinAngleCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fMaxNofPointsCmd 
+    = new G4UIcmdWithAnInteger("/mcTracking/geoTracks/maxNofPoints", this);
+  fMaxNofPointsCmd
+    ->SetGuidance("Set the maximum number of recorded points per track;");
+  fMaxNofPointsCmd
+    ->SetGuidance("when reached, the last point is replaced with the track end point.");
+  fMaxNofPointsCmd->SetGuidance("0 means no limit.");
+  fMaxNofPointsCmd->SetParameterName("MaxNofPoints", false);
+  fMaxNofPointsCmd->SetRange("MaxNofPoints == 0 || MaxNofPoints >= 2");
+  fMaxNofPointsCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fMaxMemoryCmd 
+    = new G4UIcmdWithAnInteger("/mcTracking/geoTracks/maxMemory", this);
+  fMaxMemoryCmd
+    ->SetGuidance("Set the memory budget (in MB) for recorded track points per event;");
+  fMaxMemoryCmd->SetGuidance("0 means no limit.");
+  fMaxMemoryCmd->SetParameterName("MaxMemory", false);
+  fMaxMemoryCmd->SetRange("MaxMemory >= 0");
+  fMaxMemoryCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+}
+
+//_____________________________________________________________________________
+TG4GeoTrackManagerMessenger::~TG4GeoTrackManagerMessenger() 
+{
+/// Destructor
+
+  delete fDirectory;
+  delete fMinPointDistanceCmd;
+  delete fMinAngleCmd;
+  delete fMaxNofPointsCmd;
+  delete fMaxMemoryCmd;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4GeoTrackManagerMessenger::SetNewValue(G4UIcommand* command, 
+       G4String newValue)
+{ 
+/// Apply command to the associated object.
+
+  if(command == fMinPointDistanceCmd) { 
+    fGeoTrackManager->SetMinPointDistance(
+      fMinPointDistanceCmd->GetNewDoubleValue(newValue)); 
+  }   
+  else if(command == fMinAngleCmd) { 
+    fGeoTrackManager->SetMinAngle(fMinAngleCmd->GetNewDoubleValue(newValue)); 
+  }   
+  else if(command == fMaxNofPointsCmd) { 
+    fGeoTrackManager->SetMaxNofPoints(
+      fMaxNofPointsCmd->GetNewIntValue(newValue)); 
+  }   
+  else if(command == fMaxMemoryCmd) { 
+    fGeoTrackManager->SetMaxMemory(fMaxMemoryCmd->GetNewIntValue(newValue)); 
+  }   
+}
@@ -0,0 +1,246 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4MemoryStatistics.cxx
+/// \brief Implementation of the TG4MemoryStatistics class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4MemoryStatistics.h"
+#include "TG4TrackInformation.h"
+#include "TG4TrackManager.h"
+#include "TG4SteppingAction.h"
+#include "TG4Globals.h"
+
+#include <G4Event.hh>
+#include <G4Track.hh>
+#include <G4DynamicParticle.hh>
+#include <G4TrajectoryContainer.hh>
+#include <G4Trajectory.hh>
+#include <G4TrajectoryPoint.hh>
+#include <G4AutoLock.hh>
+
+#include <TVirtualMCStack.h>
+#include <TParticle.h>
+#include <TSystem.h>
+
+#include <iomanip>
+
+// mutex in a file scope
+
+namespace {
+#ifdef G4MULTITHREADED
+  //Mutex to lock the merged statistics
+  G4Mutex mergeMutex = G4MUTEX_INITIALIZER;
+#endif
+}
+
+// static data members
+G4ThreadLocal TG4MemoryStatistics* TG4MemoryStatistics::fgInstance = 0;
+size_t  TG4MemoryStatistics::fgMaxBytes[kNofCategories] = { 0 };
+size_t  TG4MemoryStatistics::fgSumBytes[kNofCategories] = { 0 };
+G4int   TG4MemoryStatistics::fgNofThreads = 0;
+
+//_____________________________________________________________________________
+TG4MemoryStatistics::TG4MemoryStatistics()
+  : fNofEvents(0)
+{
+/// Default constructor
+
+  if ( fgInstance ) {
+    TG4Globals::Exception(
+      "TG4MemoryStatistics", "TG4MemoryStatistics",
+      "Cannot create two instances of singleton.");
+  }
+
+  for ( G4int i=0; i<kNofCategories; ++i ) {
+    fCounts[i] = 0;
+    fBytes[i] = 0;
+    fMaxCounts[i] = 0;
+    fMaxBytes[i] = 0;
+  }
+
+  fgInstance = this;
+}
+
+//_____________________________________________________________________________
+TG4MemoryStatistics::~TG4MemoryStatistics() 
+{
+/// Destructor
+
+  fgInstance = 0;
+}
+
+//
+// static methods
+//
+
+//_____________________________________________________________________________
+G4String TG4MemoryStatistics::GetCategoryName(G4int category)
+{
+/// Return the category name for printing
+
+  switch ( category ) {
+    case kTrackInformation: return "TG4TrackInformation";
+    case kStackParticles:   return "VMC stack particles";
+    case kG4Tracks:         return "G4 tracks";
+    case kTrajectories:     return "trajectories";
+    default:                return "unknown";
+  }
+}
+
+//_____________________________________________________________________________
+void TG4MemoryStatistics::PrintMerged()
+{
+/// Print the high-water marks merged from all threads
+
+  if ( ! fgNofThreads ) return;
+
+  TG4Globals::PrintStars(true);
+  G4cout << "Memory high-water marks (in bytes) from " 
+         << fgNofThreads << " thread(s): " << G4endl
+         << std::setw(22) << "category" 
+         << std::setw(16) << "max per thread"
+         << std::setw(16) << "sum of threads" << G4endl;
+
+  size_t maxTotal = 0;
+  size_t sumTotal = 0;
+  for ( G4int i=0; i<kNofCategories; ++i ) {
+    G4cout << std::setw(22) << GetCategoryName(i) 
+           << std::setw(16) << fgMaxBytes[i]
+           << std::setw(16) << fgSumBytes[i] << G4endl;
+    maxTotal += fgMaxBytes[i];
+    sumTotal += fgSumBytes[i];
+  }
+  G4cout << std::setw(22) << "total" 
+         << std::setw(16) << maxTotal
+         << std::setw(16) << sumTotal << G4endl;
+  TG4Globals::PrintStars(false);
+}
+
+//_____________________________________________________________________________
+void TG4MemoryStatistics::ClearMerged()
+{
+/// Clear the merged high-water marks
+
+  for ( G4int i=0; i<kNofCategories; ++i ) {
+    fgMaxBytes[i] = 0;
+    fgSumBytes[i] = 0;
+  }
+  fgNofThreads = 0;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4MemoryStatistics::BeginOfEvent()
+{
+/// Reset the per event counters 
+
+  TG4TrackInformation::ResetMaxNofInstances();
+}
+
+//_____________________________________________________________________________
+void TG4MemoryStatistics::EndOfEvent(const G4Event* event, 
+                                     TVirtualMCStack* mcStack)
+{
+/// Collect the object counts and the memory at the end of event
+/// and update the high-water marks
+
+  // TG4TrackInformation
+  fCounts[kTrackInformation] = TG4TrackInformation::GetMaxNofInstances();
+  fBytes[kTrackInformation] = TG4TrackInformation::GetAllocatedSize();
+
+  // VMC stack
+  fCounts[kStackParticles] = mcStack ? mcStack->GetNtrack() : 0;
+  fBytes[kStackParticles] = fCounts[kStackParticles]*sizeof(TParticle);
+
+  // G4 tracks
+  fCounts[kG4Tracks] = TG4TrackManager::Instance()->GetNofTracks();
+  fBytes[kG4Tracks] = 0;
+  if ( aTrackAllocator() ) 
+    fBytes[kG4Tracks] += aTrackAllocator()->GetAllocatedSize();
+  if ( pDynamicParticleAllocator() ) 
+    fBytes[kG4Tracks] += pDynamicParticleAllocator()->GetAllocatedSize();
+
+  // Trajectories
+  fCounts[kTrajectories] = 0;
+  fBytes[kTrajectories] = 0;
+  if ( event->GetTrajectoryContainer() ) 
+    fCounts[kTrajectories] += event->GetTrajectoryContainer()->entries();
+  if ( aTrajectoryAllocator() )
+    fBytes[kTrajectories] += aTrajectoryAllocator()->GetAllocatedSize();
+  if ( aTrajectoryPointAllocator() )
+    fBytes[kTrajectories] += aTrajectoryPointAllocator()->GetAllocatedSize();
+  if ( TG4SteppingAction::Instance() ) {
+    const TG4GeoTrackManager& geoTrackManager 
+      = TG4SteppingAction::Instance()->GetGeoTrackManager();
+    fCounts[kTrajectories] += geoTrackManager.GetNofTracks();
+    fBytes[kTrajectories] += geoTrackManager.GetNofBytes();
+  }
+
+  for ( G4int i=0; i<kNofCategories; ++i ) {
+    if ( fCounts[i] > fMaxCounts[i] ) fMaxCounts[i] = fCounts[i];
+    if ( fBytes[i] > fMaxBytes[i] ) fMaxBytes[i] = fBytes[i];
+  }
+  ++fNofEvents;
+}
+
+//_____________________________________________________________________________
+void TG4MemoryStatistics::Print(G4int eventID) const
+{
+/// Print the statistics of the last event and the high-water marks
+
+  ProcInfo_t procInfo;
+  gSystem->GetProcInfo(&procInfo);
+
+  G4cout << "Memory usage at the end of event " << eventID 
+         << ": resident " << procInfo.fMemResident 
+         << " kB, virtual " << procInfo.fMemVirtual << " kB" << G4endl
+         << std::setw(22) << "category" 
+         << std::setw(12) << "count"
+         << std::setw(14) << "bytes"
+         << std::setw(12) << "max count"
+         << std::setw(14) << "max bytes" << G4endl;
+
+  for ( G4int i=0; i<kNofCategories; ++i ) {
+    G4cout << std::setw(22) << GetCategoryName(i) 
+           << std::setw(12) << fCounts[i]
+           << std::setw(14) << fBytes[i]
+           << std::setw(12) << fMaxCounts[i]
+           << std::setw(14) << fMaxBytes[i] << G4endl;
+  }
+}
+
+//_____________________________________________________________________________
+void TG4MemoryStatistics::Merge()
+{
+/// Merge the high-water marks of this thread in the static data
+
+  if ( ! fNofEvents ) return;
+
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&mergeMutex);
+#endif
+
+  for ( G4int i=0; i<kNofCategories; ++i ) {
+    if ( fMaxBytes[i] > fgMaxBytes[i] ) fgMaxBytes[i] = fMaxBytes[i];
+    fgSumBytes[i] += fMaxBytes[i];
+  }
+  ++fgNofThreads;
+
+  // reset the thread statistics
+  for ( G4int i=0; i<kNofCategories; ++i ) {
+    fMaxCounts[i] = 0;
+    fMaxBytes[i] = 0;
+  }
+  fNofEvents = 0;
+}
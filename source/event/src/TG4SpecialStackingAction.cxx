@@ -28,11 +28,18 @@ TG4SpecialStackingAction::TG4SpecialStackingAction()
     TG4Verbose("stackingAction",1),
     fMessenger(this),
     fStage(0),
-    fSkipNeutrino(false)
+    fSkipNeutrino(false),
+    fRules(),
+    fNofAdditionalWaitingStacks(0),
+    fNofKilledTracks(0),
+    fNofStages(0),
+    fNofEvents(0)
 {
 /// Default constructor
 
   G4cout << "### TG4SpecialStackingAction activated" << G4endl;
+
+  ResetStatistics();
 }
 
 //_____________________________________________________________________________
@@ -41,6 +48,41 @@ TG4SpecialStackingAction::~TG4SpecialStackingAction()
 /// Destructor
 }
 
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4ClassificationOfNewTrack 
+TG4SpecialStackingAction::GetClassification(G4int stage) const
+{
+/// Return the Geant4 stack classification for the given relative stage
+
+  if ( stage == TG4StackingRule::kKill ) return fKill;
+  if ( stage == 0 ) return fUrgent;
+  if ( stage == 1 ) return fWaiting;
+
+  return G4ClassificationOfNewTrack(fWaiting_1 + stage - 2);
+}
+
+//_____________________________________________________________________________
+void TG4SpecialStackingAction::UpdateWaitingStacks()
+{
+/// Create the additional waiting stacks needed by the stacking rules
+/// (their number cannot be decreased)
+
+  G4int maxStage = 0;
+  for ( G4int i=0; i<G4int(fRules.size()); ++i ) {
+    if ( fRules[i].GetStage() > maxStage ) maxStage = fRules[i].GetStage();
+  }  
+
+  if ( maxStage - 1 > fNofAdditionalWaitingStacks ) {
+    fNofAdditionalWaitingStacks = maxStage - 1;
+    stackManager->SetNumberOfAdditionalWaitingStacks(
+                    fNofAdditionalWaitingStacks);
+  }
+}
+
 //
 // public methods
 //
@@ -62,10 +104,25 @@ TG4SpecialStackingAction::ClassifyNewTrack(const G4Track* track)
           pdgCode ==  kNuMu || pdgCode == kNuMuBar ||
 	  pdgCode ==  kNuTau || pdgCode == kNuTauBar ) {
 
+      ++fNofKilledTracks;
       return fKill;
     }           
   }
 
+  // apply the first matching stacking rule
+  for ( G4int i=0; i<G4int(fRules.size()); ++i ) {
+    if ( ! fRules[i].Match(track) ) continue;
+
+    G4int stage = fRules[i].GetStage();
+    if ( stage == TG4StackingRule::kKill )
+      ++fNofKilledTracks;
+    else  
+      ++fNofStageTracks[stage];
+
+    return GetClassification(stage);
+  }
+
+  ++fNofStageTracks[0];
   return fUrgent;          
 }
 
@@ -73,17 +130,31 @@ TG4SpecialStackingAction::ClassifyNewTrack(const G4Track* track)
 void TG4SpecialStackingAction::NewStage()
 {
 /// Called by G4 kernel at the new stage of stacking.
+/// The tracks from the nearest non empty additional waiting stack are 
+/// transfered to the urgent stack if the urgent and waiting stacks are 
+/// empty (otherwise the event would be finished); the next primary track 
+/// is transfered only if all stacks are empty.
 
   fStage++;
+  ++fNofStages;
   
   if (VerboseLevel() > 1) {
     G4cout << "TG4SpecialStackingAction::NewStage " << fStage 
            << " has been started." << G4endl;
   }
 
-  if (stackManager->GetNUrgentTrack() == 0 &&
-      stackManager->GetNPostponedTrack() != 0 ) {
-      
+  if ( stackManager->GetNUrgentTrack() != 0 || 
+       stackManager->GetNWaitingTrack(0) != 0 ) return;
+
+  for ( G4int i=1; i<=fNofAdditionalWaitingStacks; ++i ) {
+    if ( stackManager->GetNWaitingTrack(i) != 0 ) {
+      stackManager->TransferStackedTracks(
+        G4ClassificationOfNewTrack(fWaiting_1 + i - 1), fUrgent);
+      return;
+    }
+  }        
+
+  if ( stackManager->GetNPostponedTrack() != 0 ) {
       stackManager->TransferOneStackedTrack(fPostpone, fUrgent);
   }
 }
@@ -95,6 +166,66 @@ void TG4SpecialStackingAction::PrepareNewEvent()
 ///  secondaries are not ordered even when the special stacking is activated.
 
   fStage = 0;
+  ++fNofEvents;
+
+  UpdateWaitingStacks();
+}
+
+//_____________________________________________________________________________
+void TG4SpecialStackingAction::AddRule(const TG4StackingRule& rule)
+{
+/// Add the stacking rule; the rules are applied in the order of their 
+/// addition.
+
+  fRules.push_back(rule);
+}
+
+//_____________________________________________________________________________
+void TG4SpecialStackingAction::ClearRules()
+{
+/// Remove all stacking rules
+
+  fRules.clear();
+}
+
+//_____________________________________________________________________________
+void TG4SpecialStackingAction::PrintRules() const
+{
+/// Print all stacking rules
+
+  G4cout << "Stacking rules: ";
+  if ( ! fRules.size() ) G4cout << "none";
+  G4cout << G4endl;
+
+  for ( G4int i=0; i<G4int(fRules.size()); ++i ) fRules[i].Print();
+}
+
+//_____________________________________________________________________________
+void TG4SpecialStackingAction::PrintStatistics() const
+{
+/// Print the number of tracks classified in each stage
+
+  G4cout << "Stacking statistics: " << G4endl
+         << "  events processed:   " << fNofEvents << G4endl
+         << "  stages processed:   " << fNofStages << G4endl;
+
+  for ( G4int i=0; i<=TG4StackingRule::kMaxStage; ++i ) {
+    if ( ! fNofStageTracks[i] ) continue;
+    G4cout << "  tracks in stage " << i << ":  " << fNofStageTracks[i] << G4endl;
+  }
+
+  G4cout << "  tracks killed:      " << fNofKilledTracks << G4endl;
+}
+
+//_____________________________________________________________________________
+void TG4SpecialStackingAction::ResetStatistics()
+{
+/// Reset all statistics counters
+
+  for ( G4int i=0; i<=TG4StackingRule::kMaxStage; ++i ) fNofStageTracks[i] = 0;
+  fNofKilledTracks = 0;
+  fNofStages = 0;
+  fNofEvents = 0;
 }
 
 
@@ -14,17 +14,32 @@
 
 #include "TG4SpecialStackingActionMessenger.h"
 #include "TG4SpecialStackingAction.h"
+#include "TG4StackingRule.h"
+#include "TG4G3Units.h"
 #include "TG4Globals.h"
 
+#include <G4UIdirectory.hh>
 #include <G4UIcmdWithAnInteger.hh>
 #include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithoutParameter.hh>
+#include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
+#include <G4AnalysisUtilities.hh>
+
+#include <limits>
 
 //_____________________________________________________________________________
 TG4SpecialStackingActionMessenger::TG4SpecialStackingActionMessenger(
                                       TG4SpecialStackingAction* stackingAction)
   : G4UImessenger(),
     fStackingAction(stackingAction),
-    fSkipNeutrinoCmd(0)
+    fSkipNeutrinoCmd(0),
+    fRulesDirectory(0),
+    fAddRuleCmd(0),
+    fClearRulesCmd(0),
+    fPrintRulesCmd(0),
+    fPrintStatisticsCmd(0),
+    fResetStatisticsCmd(0)
 {
 /// Standard constructor
 
@@ -33,6 +48,61 @@ TG4SpecialStackingActionMessenger::TG4SpecialStackingActionMessenger(
   fSkipNeutrinoCmd->SetGuidance("By default this option is false.");
   fSkipNeutrinoCmd->SetParameterName("SkipNeutrino", false);
   fSkipNeutrinoCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fRulesDirectory = new G4UIdirectory("/mcTracking/stackingRules/");
+  fRulesDirectory->SetGuidance("Stacking rules for secondary tracks.");
+
+  G4UIparameter* stage = new G4UIparameter("stage", 's', false);
+  stage->SetGuidance("The stage relative to the current one (0 - 9) or kill.");
+  G4UIparameter* pdg = new G4UIparameter("pdg", 'i', true);
+  pdg->SetGuidance("The PDG code; all particles if 0.");
+  pdg->SetDefaultValue(0);
+  G4UIparameter* minEkin = new G4UIparameter("minEkin", 'd', true);
+  minEkin->SetGuidance("The minimum kinetic energy (GeV).");
+  minEkin->SetDefaultValue(0.);
+  G4UIparameter* maxEkin = new G4UIparameter("maxEkin", 'd', true);
+  maxEkin->SetGuidance("The maximum kinetic energy (GeV); no limit if negative.");
+  maxEkin->SetDefaultValue(-1.);
+  G4UIparameter* region = new G4UIparameter("region", 's', true);
+  region->SetGuidance("The region where the track is created; all regions if all.");
+  region->SetDefaultValue("all");
+  G4UIparameter* minTime = new G4UIparameter("minTime", 'd', true);
+  minTime->SetGuidance("The minimum global time (s).");
+  minTime->SetDefaultValue(0.);
+
+  fAddRuleCmd = new G4UIcommand("/mcTracking/stackingRules/add", this);
+  fAddRuleCmd->SetGuidance("Add the rule for stacking of secondary tracks.");
+  fAddRuleCmd->SetGuidance("The tracks matching the rule criteria are processed in the given");
+  fAddRuleCmd->SetGuidance("stage (relative to the current one) or killed;");
+  fAddRuleCmd->SetGuidance("the first matching rule is applied.");
+  fAddRuleCmd->SetGuidance("Available only with the special stacking.");
+  fAddRuleCmd->SetParameter(stage);
+  fAddRuleCmd->SetParameter(pdg);
+  fAddRuleCmd->SetParameter(minEkin);
+  fAddRuleCmd->SetParameter(maxEkin);
+  fAddRuleCmd->SetParameter(region);
+  fAddRuleCmd->SetParameter(minTime);
+  fAddRuleCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fClearRulesCmd 
+    = new G4UIcmdWithoutParameter("/mcTracking/stackingRules/clear", this);
+  fClearRulesCmd->SetGuidance("Remove all stacking rules.");
+  fClearRulesCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fPrintRulesCmd 
+    = new G4UIcmdWithoutParameter("/mcTracking/stackingRules/print", this);
+  fPrintRulesCmd->SetGuidance("Print all stacking rules.");
+  fPrintRulesCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fPrintStatisticsCmd 
+    = new G4UIcmdWithoutParameter("/mcTracking/stackingRules/printStatistics", this);
+  fPrintStatisticsCmd->SetGuidance("Print the number of tracks classified in each stage.");
+  fPrintStatisticsCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fResetStatisticsCmd 
+    = new G4UIcmdWithoutParameter("/mcTracking/stackingRules/resetStatistics", this);
+  fResetStatisticsCmd->SetGuidance("Reset the stacking statistics.");
+  fResetStatisticsCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
 }
 
 //_____________________________________________________________________________
@@ -41,6 +111,12 @@ TG4SpecialStackingActionMessenger::~TG4SpecialStackingActionMessenger()
 /// Destructor
 
   delete fSkipNeutrinoCmd;
+  delete fRulesDirectory;
+  delete fAddRuleCmd;
+  delete fClearRulesCmd;
+  delete fPrintRulesCmd;
+  delete fPrintStatisticsCmd;
+  delete fResetStatisticsCmd;
 }
 
 //
@@ -57,4 +133,46 @@ void TG4SpecialStackingActionMessenger::SetNewValue(G4UIcommand* command,
     fStackingAction
       ->SetSkipNeutrino(fSkipNeutrinoCmd->GetNewBoolValue(newValue)); 
   }   
+  else if ( command == fAddRuleCmd ) {
+    // tokenize parameters in a vector
+    std::vector<G4String> parameters;
+    G4Analysis::Tokenize(newValue, parameters);
+
+    G4int counter = 0;
+    G4String stageName = parameters[counter++];
+    G4int stage = ( stageName == "kill" ) 
+                ? G4int(TG4StackingRule::kKill)
+                : G4UIcommand::ConvertToInt(stageName);
+    G4int pdg = G4UIcommand::ConvertToInt(parameters[counter++]);
+    G4double minEkin = G4UIcommand::ConvertToDouble(parameters[counter++]);
+    G4double maxEkin = G4UIcommand::ConvertToDouble(parameters[counter++]);
+    G4String regionName = parameters[counter++];
+    G4double minTime = G4UIcommand::ConvertToDouble(parameters[counter++]);
+
+    // apply units
+    minEkin *= TG4G3Units::Energy();
+    if ( maxEkin < 0. ) 
+      maxEkin = std::numeric_limits<G4double>::max();
+    else
+      maxEkin *= TG4G3Units::Energy();
+    minTime *= TG4G3Units::Time();  
+
+    TG4StackingRule rule(stage, pdg);
+    rule.SetEkinRange(minEkin, maxEkin);
+    rule.SetMinGlobalTime(minTime);
+    if ( regionName != "all" ) rule.SetRegionName(regionName);
+    fStackingAction->AddRule(rule);
+  }
+  else if ( command == fClearRulesCmd ) {
+    fStackingAction->ClearRules();
+  }
+  else if ( command == fPrintRulesCmd ) {
+    fStackingAction->PrintRules();
+  }
+  else if ( command == fPrintStatisticsCmd ) {
+    fStackingAction->PrintStatistics();
+  }
+  else if ( command == fResetStatisticsCmd ) {
+    fStackingAction->ResetStatistics();
+  }
 }
@@ -0,0 +1,130 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4StackingRule.cxx
+/// \brief Implementation of the TG4StackingRule class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TG4StackingRule.h"
+#include "TG4ParticlesManager.h"
+#include "TG4G3Units.h"
+#include "TG4Globals.h"
+
+#include <G4Track.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+
+#include <limits>
+
+//_____________________________________________________________________________
+TG4StackingRule::TG4StackingRule(G4int stage, G4int pdg)
+  : fStage(stage),
+    fPdg(pdg),
+    fMinEkin(0.),
+    fMaxEkin(std::numeric_limits<G4double>::max()),
+    fMinGlobalTime(0.),
+    fRegionName(),
+    fRegion(0),
+    fIsResolved(false)
+{
+/// Standard constructor
+
+  if ( fStage < kKill || fStage > kMaxStage ) {
+    TString text = "The stage ";
+    text += fStage;
+    text += " is out of range.";
+    text += TG4Globals::Endl();
+    text += "The nearest valid value will be used.";
+    TG4Globals::Warning("TG4StackingRule", "TG4StackingRule", text);
+    fStage = ( fStage < kKill ) ? kKill : kMaxStage;
+  }   
+}
+
+//_____________________________________________________________________________
+TG4StackingRule::~TG4StackingRule()
+{
+/// Destructor
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4StackingRule::ResolveRegion() const
+{
+/// Find the region with the rule region name
+
+  fIsResolved = true;
+  fRegion = G4RegionStore::GetInstance()->GetRegion(fRegionName, false);
+
+  if ( ! fRegion ) {
+    TG4Globals::Warning(
+      "TG4StackingRule", "ResolveRegion", 
+      TString("Region ") + fRegionName.data() + " not found." +
+      TG4Globals::Endl() + TString("The stacking rule will not be applied."));
+  }    
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+G4bool TG4StackingRule::Match(const G4Track* track) const
+{
+/// Return true if the track passes all rule criteria.
+/// The cheapest criteria are evaluated first.
+
+  G4double ekin = track->GetKineticEnergy();
+  if ( ekin < fMinEkin || ekin > fMaxEkin ) return false;
+
+  if ( track->GetGlobalTime() < fMinGlobalTime ) return false;
+
+  if ( fPdg != 0 && 
+       TG4ParticlesManager::Instance()->GetPDGEncoding(track->GetDefinition())
+         != fPdg ) return false;
+
+  if ( fRegionName.size() ) {
+    if ( ! fIsResolved ) ResolveRegion();
+    if ( ! fRegion ) return false;
+
+    G4VPhysicalVolume* pv = track->GetVolume();
+    if ( ! pv || pv->GetLogicalVolume()->GetRegion() != fRegion ) return false;
+  }  
+
+  return true;
+}
+
+//_____________________________________________________________________________
+void TG4StackingRule::Print() const
+{
+/// Print the rule criteria (in G3 units)
+
+  G4cout << "  stage = ";
+  if ( fStage == kKill ) 
+    G4cout << "kill";
+  else  
+    G4cout << fStage;
+  G4cout << "  pdg = " << fPdg
+         << "  Ekin range = (" << fMinEkin/TG4G3Units::Energy() << ", ";
+  if ( fMaxEkin < std::numeric_limits<G4double>::max() )
+    G4cout << fMaxEkin/TG4G3Units::Energy();
+  else
+    G4cout << "inf";
+  G4cout << ") GeV"
+         << "  minTime = " << fMinGlobalTime/TG4G3Units::Time() << " s";
+  if ( fRegionName.size() )
+    G4cout << "  region = " << fRegionName;
+  G4cout << G4endl;
+}
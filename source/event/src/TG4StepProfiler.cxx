@@ -0,0 +1,283 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4StepProfiler.cxx
+/// \brief Implementation of the TG4StepProfiler class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4StepProfiler.h"
+#include "TG4Globals.h"
+
+#include <G4Step.hh>
+#include <G4VProcess.hh>
+#include <G4LogicalVolume.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4AutoLock.hh>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+// mutex in a file scope
+
+namespace {
+#ifdef G4MULTITHREADED
+  //Mutex to lock the merged counters
+  G4Mutex mergeMutex = G4MUTEX_INITIALIZER;
+#endif
+
+  // the comparison of the counters by time
+  typedef std::pair<G4String, TG4StepProfiler::Counter>  CounterEntry;
+  G4bool CompareByTime(const CounterEntry& lhs, const CounterEntry& rhs) {
+    return lhs.second.fTime > rhs.second.fTime;
+  }
+}
+
+// static data members
+G4bool    TG4StepProfiler::fgIsActive = false;
+G4int     TG4StepProfiler::fgSampling = 1;
+G4int     TG4StepProfiler::fgNofTop = 20;
+G4String  TG4StepProfiler::fgOutputFileName = "";
+TG4StepProfiler::CounterMap  TG4StepProfiler::fgVolumeCounters;
+TG4StepProfiler::CounterMap  TG4StepProfiler::fgParticleCounters;
+TG4StepProfiler::CounterMap  TG4StepProfiler::fgProcessCounters;
+
+//_____________________________________________________________________________
+TG4StepProfiler::TG4StepProfiler()
+  : fStepCounter(0),
+    fStartTime(),
+    fHasStartTime(false),
+    fVolumeCounters(),
+    fParticleCounters(),
+    fProcessCounters()
+{
+/// Default constructor
+}
+
+//_____________________________________________________________________________
+TG4StepProfiler::~TG4StepProfiler() 
+{
+/// Destructor
+}
+
+//
+// static private methods
+//
+
+//_____________________________________________________________________________
+void TG4StepProfiler::PrintTop(const G4String& title, 
+                               const CounterMap& counters)
+{
+/// Print the first fgNofTop entries sorted by time
+
+  std::vector<CounterEntry> entries(counters.begin(), counters.end());
+  std::sort(entries.begin(), entries.end(), CompareByTime);
+
+  G4long totalNofSteps = 0;
+  G4double totalTime = 0.;
+  for ( G4int i=0; i<G4int(entries.size()); ++i ) {
+    totalNofSteps += entries[i].second.fNofSteps;
+    totalTime += entries[i].second.fTime;
+  }
+
+  G4cout << "Step profile per " << title 
+         << " (total: " << totalNofSteps << " steps, " 
+         << totalTime << " s)" << G4endl;
+
+  G4int nofEntries = std::min(G4int(entries.size()), fgNofTop);
+  for ( G4int i=0; i<nofEntries; ++i ) {
+    const Counter& counter = entries[i].second;
+    G4cout << "  " << std::left << std::setw(24) << entries[i].first
+           << std::right << std::setw(12) << counter.fNofSteps << " steps "
+           << std::setw(12) << counter.fTime << " s ";
+    if ( totalTime > 0. ) 
+      G4cout << std::setw(6) << std::setprecision(3) 
+             << counter.fTime/totalTime*100. << std::setprecision(6) << " %";
+    G4cout << G4endl;
+  }
+}
+
+//
+// static public methods
+//
+
+//_____________________________________________________________________________
+void TG4StepProfiler::SetSampling(G4int sampling)
+{
+/// Set the time sampling: the time is measured only for each N-th step
+
+  if ( sampling < 1 ) {
+    TG4Globals::Warning(
+      "TG4StepProfiler", "SetSampling",
+      "The sampling must be >= 1; setting was ignored.");
+    return;
+  }
+
+  fgSampling = sampling;
+}
+
+//_____________________________________________________________________________
+void TG4StepProfiler::PrintReport()
+{
+/// Print the top N entries of the merged counters
+
+  TG4Globals::PrintStars(true);
+  PrintTop("logical volume", fgVolumeCounters);
+  G4cout << G4endl;
+  PrintTop("particle", fgParticleCounters);
+  G4cout << G4endl;
+  PrintTop("process", fgProcessCounters);
+  TG4Globals::PrintStars(false);
+}
+
+//_____________________________________________________________________________
+void TG4StepProfiler::WriteTable()
+{
+/// Write all merged counters in the CSV file with the columns:
+/// category, name, nofSteps, time
+
+  if ( ! fgOutputFileName.size() ) return;
+
+  std::ofstream output(fgOutputFileName.data());
+  if ( ! output ) {
+    TG4Globals::Warning(
+      "TG4StepProfiler", "WriteTable",
+      "Cannot open file " + TString(fgOutputFileName.data()));
+    return;
+  }
+
+  output << "category,name,nofSteps,time" << std::endl;
+
+  const CounterMap* counterMaps[3] 
+    = { &fgVolumeCounters, &fgParticleCounters, &fgProcessCounters };
+  const char* categories[3] = { "volume", "particle", "process" };
+
+  for ( G4int i=0; i<3; ++i ) {
+    CounterMap::const_iterator it;
+    for ( it = counterMaps[i]->begin(); it != counterMaps[i]->end(); ++it ) {
+      output << categories[i] << "," << it->first << "," 
+             << it->second.fNofSteps << "," << it->second.fTime << std::endl;
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void TG4StepProfiler::ClearMerged()
+{
+/// Clear the merged counters
+
+  fgVolumeCounters.clear();
+  fgParticleCounters.clear();
+  fgProcessCounters.clear();
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4StepProfiler::StartStep()
+{
+/// Record the start time of the next step if it is sampled.
+/// Called at the end of the stepping action and of the pre-tracking action.
+
+  fHasStartTime = ( ( fStepCounter + 1 ) % fgSampling == 0 );
+  if ( fHasStartTime ) fStartTime = std::chrono::steady_clock::now();
+}
+
+//_____________________________________________________________________________
+void TG4StepProfiler::ProfileStep(const G4Step* step)
+{
+/// Count the step and add its time (if sampled) in the counters 
+/// of the step volume, particle and the process which limited the step.
+
+  G4double time = 0.;
+  if ( fHasStartTime ) {
+    time = std::chrono::duration<G4double>(
+             std::chrono::steady_clock::now() - fStartTime).count() 
+           * fgSampling;
+    fHasStartTime = false;
+  }
+  ++fStepCounter;
+
+  // volume
+  size_t lvID 
+    = step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()
+        ->GetInstanceID();
+  if ( lvID >= fVolumeCounters.size() ) fVolumeCounters.resize(lvID + 1);
+  ++fVolumeCounters[lvID].fNofSteps;
+  fVolumeCounters[lvID].fTime += time;
+
+  // particle
+  Counter& particleCounter 
+    = fParticleCounters[step->GetTrack()->GetDefinition()];
+  ++particleCounter.fNofSteps;
+  particleCounter.fTime += time;
+
+  // process
+  Counter& processCounter 
+    = fProcessCounters[step->GetPostStepPoint()->GetProcessDefinedStep()];
+  ++processCounter.fNofSteps;
+  processCounter.fTime += time;
+}
+
+//_____________________________________________________________________________
+void TG4StepProfiler::Merge()
+{
+/// Merge the counters of this thread in the merged counters (by names)
+/// and reset them.
+
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&mergeMutex);
+#endif
+
+  // volumes
+  G4LogicalVolumeStore* lvStore = G4LogicalVolumeStore::GetInstance();
+  for ( G4int i=0; i<G4int(lvStore->size()); ++i ) {
+    size_t lvID = (*lvStore)[i]->GetInstanceID();
+    if ( lvID >= fVolumeCounters.size() || 
+         ! fVolumeCounters[lvID].fNofSteps ) continue;
+
+    Counter& counter = fgVolumeCounters[(*lvStore)[i]->GetName()];
+    counter.fNofSteps += fVolumeCounters[lvID].fNofSteps;
+    counter.fTime += fVolumeCounters[lvID].fTime;
+  }
+
+  // particles
+  std::unordered_map<const G4ParticleDefinition*, Counter>::const_iterator 
+    itpa;
+  for ( itpa = fParticleCounters.begin(); 
+        itpa != fParticleCounters.end(); ++itpa ) {
+    Counter& counter = fgParticleCounters[itpa->first->GetParticleName()];
+    counter.fNofSteps += itpa->second.fNofSteps;
+    counter.fTime += itpa->second.fTime;
+  }
+
+  // processes
+  std::unordered_map<const G4VProcess*, Counter>::const_iterator itp;
+  for ( itp = fProcessCounters.begin(); itp != fProcessCounters.end(); ++itp ) {
+    G4String name = itp->first ? itp->first->GetProcessName() : "none";
+    Counter& counter = fgProcessCounters[name];
+    counter.fNofSteps += itp->second.fNofSteps;
+    counter.fTime += itp->second.fTime;
+  }
+
+#ifdef G4MULTITHREADED
+  lm.unlock();
+#endif
+
+  // reset
+  fVolumeCounters.clear();
+  fParticleCounters.clear();
+  fProcessCounters.clear();
+  fStepCounter = 0;
+  fHasStartTime = false;
+}
@@ -21,6 +21,8 @@
 #include "TG4SpecialControlsV2.h"
 #include "TG4SDServices.h"
 #include "TG4StackPopper.h"
+#include "TG4PhysicsManager.h"
+#include "TG4CallbackTimer.h"
 #include "TG4Limits.h"
 #include "TG4G3Units.h"
 #include "TG4Globals.h"
@@ -38,6 +40,7 @@ TG4SteppingAction::TG4SteppingAction()
   : G4UserSteppingAction(),
     fMessenger(this),
     fGeoTrackManager(),
+    fStepProfiler(),
     fSpecialControls(0), 
     fMCApplication(0),
     fTrackManager(0),
@@ -156,7 +159,8 @@ void TG4SteppingAction::ProcessTrackIfBelowCut(const G4Step* step)
 /// Flag e+e- secondary pair for stop if its energy is below user cut
 
   if ( step->GetSecondary()->size() == 2 &&
-       ( (*step->GetSecondary())[0]->GetCreatorProcess()->GetProcessName() == "muPairProd" ) ) {
+       TG4PhysicsManager::Instance()->IsMuPairProd(
+         (*step->GetSecondary())[0]->GetCreatorProcess()) ) {
   
     G4double minEtotPair
       = fStepManager->GetCurrentLimits()->GetCutVector()->GetMinEtotPair();
@@ -296,6 +300,10 @@ void TG4SteppingAction::UserSteppingAction(const G4Step* step)
 /// there is defined SteppingAction(const G4Step* step) method
 /// for this purpose. 
  
+  // profile step if activated
+  if ( TG4StepProfiler::IsActive() ) 
+    fStepProfiler.ProfileStep(step);
+
   // stop track if maximum number of steps has been reached
   ProcessTrackIfLooping(step);  
 
@@ -345,7 +353,12 @@ void TG4SteppingAction::UserSteppingAction(const G4Step* step)
   }   
         
   // call stepping action of derived class
-  SteppingAction(step);
+  {
+#ifdef USE_CALLBACK_TIMING
+    TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kSteppingAction);
+#endif
+    SteppingAction(step);
+  }
 
   // actions on the boundary
   if ( step->GetPostStepPoint()->GetStepStatus() == fGeomBoundary ) {
@@ -367,4 +380,8 @@ void TG4SteppingAction::UserSteppingAction(const G4Step* step)
     //track->SetTrackStatus(fStopButAlive);
     track->SetTrackStatus(fAlive);
   }
+
+  // start timing of the next step if profiling is activated
+  if ( TG4StepProfiler::IsActive() ) 
+    fStepProfiler.StartStep();
 }
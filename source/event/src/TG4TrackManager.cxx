@@ -26,6 +26,7 @@
 #include <TVirtualMC.h>
 #include <TVirtualMCApplication.h>
 #include <TVirtualMC.h>
+#include <TVirtualMCStackWithKeepFlag.h>
 
 #include <G4TrackVector.hh>
 #include <G4TrackingManager.hh>
@@ -43,8 +44,11 @@ TG4TrackManager::TG4TrackManager()
     fG4TrackingManager(0),   
     fTrackSaveControl(kSaveInPreTrack),
     fMCStack(0),
+    fKeepFlagMCStack(0),
+    fTrackSavePolicy(),
     fStackPopper(0),
     fSaveDynamicCharge(false),
+    fOverwriteTracks(false),
     fTrackCounter(0),
     fCurrentTrackID(0),
     fNofSavedSecondaries(0)
@@ -168,19 +172,20 @@ void TG4TrackManager::SetParentToTrackInformation(const G4Track* track)
 
   if ( ! secondaryTracks ) return;
   
-  for ( G4int i=fNofSavedSecondaries; i<G4int(secondaryTracks->size()); i++) {
-    G4Track* secondary = (*secondaryTracks)[i]; 
-
-    // get parent track index
-    TG4TrackInformation* parentInfo = GetTrackInformation(track);
+  // get parent track index
+  // (the same for all secondaries, no need to look it up in the loop)
+  TG4TrackInformation* parentInfo = GetTrackInformation(track);
 #ifdef MCDEBUG
-    if ( ! parentInfo ) {
-      TG4Globals::Exception("TG4TrackManager", "SetParentToTrackInformation",
-        "Parent track has no TG4TrackInformation set.");
-      return;
-    }    
+  if ( ! parentInfo ) {
+    TG4Globals::Exception("TG4TrackManager", "SetParentToTrackInformation",
+      "Parent track has no TG4TrackInformation set.");
+    return;
+  }    
 #endif  
-    G4int parentParticleID = parentInfo->GetTrackParticleID();
+  G4int parentParticleID = parentInfo->GetTrackParticleID();
+
+  for ( G4int i=fNofSavedSecondaries; i<G4int(secondaryTracks->size()); i++) {
+    G4Track* secondary = (*secondaryTracks)[i]; 
 
     // get or create track information and set it to the G4Track
     TG4TrackInformation* trackInfo = GetTrackInformation(secondary);
@@ -211,16 +216,40 @@ void  TG4TrackManager::SetBackPDGLifetime(const G4Track* aTrack)
     }  
 }  
 
-#ifdef STACK_WITH_KEEP_FLAG  
 //_____________________________________________________________________________
-void TG4TrackManager::TrackToStack(const G4Track* track, G4bool overWrite)
-#else
+void TG4TrackManager::SetMCStack(TVirtualMCStack* mcStack)
+{
+/// Set cached pointer to thread-local VMC stack
+/// and check if it implements the keep flag interface
+
+  G4bool isNewStack = ( mcStack != fMCStack );
+
+  fMCStack = mcStack;
+  fKeepFlagMCStack = dynamic_cast<TVirtualMCStackWithKeepFlag*>(mcStack);
+  
+  if ( isNewStack ) CheckOverwriteTracks();
+}
+
+//_____________________________________________________________________________
+void TG4TrackManager::SetOverwriteTracks(G4bool overwriteTracks)
+{
+/// Activate/inactivate the overwriting of finished leaf tracks in the stack;
+/// it is applied only if the VMC stack implements TVirtualMCStackWithKeepFlag
+
+  fOverwriteTracks = overwriteTracks;
+  CheckOverwriteTracks();
+}
+
 //_____________________________________________________________________________
-void TG4TrackManager::TrackToStack(const G4Track* track, G4bool /*overWrite*/)
-#endif
+void TG4TrackManager::TrackToStack(const G4Track* track, G4bool overWrite,
+                                   G4bool atVertex)
 {
 /// Get all needed parameters from G4track and pass them
 /// to the VMC stack.
+/// If overWrite is true, the track replaces the last track in the stack;
+/// the caller is responsible for checking that the overwriting is allowed
+/// (see TVirtualMCStackWithKeepFlag).
+/// If atVertex is true, the track kinematics is taken at its vertex.
 
   if ( VerboseLevel() > 2 )
     G4cout << "TG4TrackManager::TrackToStack" << G4endl;
@@ -240,26 +269,30 @@ void TG4TrackManager::TrackToStack(const G4Track* track, G4bool /*overWrite*/)
     = TG4ParticlesManager::Instance()->GetPDGEncoding(track->GetDefinition());
 
   // track kinematics  
-  G4ThreeVector momentum = track->GetMomentum();
+  G4ThreeVector momentum;
+  G4ThreeVector position; 
+  G4double e;
+  G4double t;
+  if ( ! atVertex ) {
+    momentum = track->GetMomentum();
+    e = track->GetTotalEnergy();
+    position = track->GetPosition(); 
+    t = track->GetGlobalTime();
+  }
+  else {
+    G4double mass = track->GetDynamicParticle()->GetMass();
+    G4double ekin = track->GetVertexKineticEnergy();
+    momentum = track->GetVertexMomentumDirection() * sqrt(ekin*(ekin + 2.*mass));
+    e = ekin + mass;
+    position = track->GetVertexPosition(); 
+    t = track->GetGlobalTime() - track->GetLocalTime();
+  }
   momentum *= 1./(TG4G3Units::Energy()); 
-  
-  G4double px = momentum.x();
-  G4double py = momentum.y();
-  G4double pz = momentum.z();
-  G4double e = track->GetTotalEnergy()/TG4G3Units::Energy();  
-
-  G4ThreeVector position = track->GetPosition(); 
+  e /= TG4G3Units::Energy();  
   position *= 1./(TG4G3Units::Length());
-  G4double vx = position.x();
-  G4double vy = position.y();
-  G4double vz = position.z();
-  G4double t = track->GetGlobalTime()/TG4G3Units::Time();
-  
+  t /= TG4G3Units::Time();
 
-  G4ThreeVector polarization = track->GetPolarization(); 
-  G4double polX = polarization.x();
-  G4double polY = polarization.y();
-  G4double polZ = polarization.z();
+  const G4ThreeVector& polarization = track->GetPolarization(); 
 
   // production process
   TMCProcess mcProcess;  
@@ -273,8 +306,6 @@ void TG4TrackManager::TrackToStack(const G4Track* track, G4bool /*overWrite*/)
     if (mcProcess == kPEnergyLoss) mcProcess = kPDeltaRay;
   }  
   
-  G4double weight = track->GetWeight();
-
   G4int status = 0;
   if ( fSaveDynamicCharge ) {
     // Store the dynamic particle charge (which in case of ion may
@@ -282,21 +313,24 @@ void TG4TrackManager::TrackToStack(const G4Track* track, G4bool /*overWrite*/)
     // place where we can do it
     status = G4int(track->GetDynamicParticle()->GetCharge()/eplus); 
   }    
-  
+
   G4int ntr;
-#ifdef STACK_WITH_KEEP_FLAG  
-  // create particle 
-  fMCStack
-    ->PushTrack(0, motherIndex, pdg, px, py, pz, e, vx, vy, vz, t,
-                polX, polY, polZ, mcProcess, ntr, weight, status,
-                overWrite);
-        // Experimental code with flagging tracks in stack for overwrite; 
-        // not yet available in distribution
-#else              
-  fMCStack
-    ->PushTrack(0, motherIndex, pdg, px, py, pz, e, vx, vy, vz, t,
-                polX, polY, polZ, mcProcess, ntr, weight, status);
-#endif
+  if ( overWrite && fKeepFlagMCStack ) {
+    fKeepFlagMCStack
+      ->OverwriteLastTrack(0, motherIndex, pdg, 
+                           momentum.x(), momentum.y(), momentum.z(), e,
+                           position.x(), position.y(), position.z(), t,
+                           polarization.x(), polarization.y(), polarization.z(),
+                           mcProcess, ntr, track->GetWeight(), status);
+  }
+  else {
+    fMCStack
+      ->PushTrack(0, motherIndex, pdg, 
+                  momentum.x(), momentum.y(), momentum.z(), e,
+                  position.x(), position.y(), position.z(), t,
+                  polarization.x(), polarization.y(), polarization.z(),
+                  mcProcess, ntr, track->GetWeight(), status);
+  }
 }
 
 //_____________________________________________________________________________
@@ -368,6 +402,7 @@ void TG4TrackManager::SaveSecondaries(const G4Track* track,
   // Store parent track Id 
   SetParentToTrackInformation(track);
   
+  G4bool applyPolicy = fTrackSavePolicy.IsActive();
   for ( G4int i=fNofSavedSecondaries; i<G4int(secondaries->size()); ++i) {
 
     G4Track* secondary =  (*secondaries)[i];      
@@ -376,21 +411,68 @@ void TG4TrackManager::SaveSecondaries(const G4Track* track,
     //       << secondary->GetDefinition()->GetParticleName()
     //       << G4endl;
           
-    if ( GetTrackInformation(secondary) &&
-         GetTrackInformation(secondary)->IsUserTrack() ) return;
+    TG4TrackInformation* trackInfo = GetTrackInformation(secondary);
+    if ( trackInfo && trackInfo->IsUserTrack() ) return;
   
     // Set track Id
     SetTrackInformation(secondary);
+    ++fNofSavedSecondaries;  
+
+    // Apply the track save policy
+    if ( applyPolicy && ! fTrackSavePolicy.Select(secondary) ) {
+      DropTrack(secondary);
+      continue;
+    }  
 
     // Save track in stack 
     TrackToStack(secondary);
                    
     // Notify a stack popper (if activated) about saving this secondary
     if ( fStackPopper ) fStackPopper->Notify();
-    ++fNofSavedSecondaries;  
   }    
 }
 
+//_____________________________________________________________________________
+G4int TG4TrackManager::DropTrack(const G4Track* track)
+{
+/// Mark the track as not saved in the VMC stack and set to it the stack index
+/// of its nearest saved ancestor (its parent particle ID, which is already 
+/// re-linked if the parent was not saved either). 
+/// Return the new track index.
+
+  TG4TrackInformation* trackInfo = GetTrackInformation(track);
+  trackInfo->SetTrackParticleID(trackInfo->GetParentParticleID());
+  trackInfo->SetIsDropped(true);
+
+  if ( VerboseLevel() > 2 ) {
+    G4cout << "TG4TrackManager::DropTrack: track " << track->GetTrackID() 
+           << " attributed to " << trackInfo->GetTrackParticleID() << G4endl;
+  }
+
+  return trackInfo->GetTrackParticleID();
+}
+
+//_____________________________________________________________________________
+void TG4TrackManager::SaveDroppedTrack(const G4Track* track)
+{
+/// Save the track, which was not saved by the track save policy, 
+/// in the VMC stack (with its vertex properties) and make it the current
+/// track in the stack. Do nothing if the track was already saved.
+
+  TG4TrackInformation* trackInfo = GetTrackInformation(track);
+  if ( ! trackInfo || ! trackInfo->IsDropped() ) return;
+
+  G4int trackIndex = fMCStack->GetNtrack();
+  trackInfo->SetTrackParticleID(trackIndex);
+  trackInfo->SetIsDropped(false);
+
+  TrackToStack(track, false, true);
+  fMCStack->SetCurrentTrack(trackIndex);
+
+  // Notify a stack popper (if activated) about saving this track
+  if ( fStackPopper ) fStackPopper->Notify();
+}
+
 //_____________________________________________________________________________
 void TG4TrackManager::ResetPrimaryParticleIds()
 {
@@ -433,3 +515,22 @@ G4bool TG4TrackManager::IsUserTrack(const G4Track* track) const
   return  
    GetTrackInformation(track) != 0x0 && GetTrackInformation(track)->IsUserTrack();
 }
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4TrackManager::CheckOverwriteTracks() const
+{
+/// Warn if the overwriting of tracks is activated but it is not supported
+/// by the VMC stack
+
+  if ( fOverwriteTracks && fMCStack && ! fKeepFlagMCStack ) {
+    TG4Globals::Warning(
+      "TG4TrackManager", "CheckOverwriteTracks", 
+      "The VMC stack does not implement TVirtualMCStackWithKeepFlag." + 
+      TG4Globals::Endl() + 
+      "The overwriting of tracks will be ignored.");
+  }      
+}
@@ -0,0 +1,267 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4TrackSavePolicy.cxx
+/// \brief Implementation of the TG4TrackSavePolicy class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4TrackSavePolicy.h"
+#include "TG4VTrackSelection.h"
+#include "TG4GeometryServices.h"
+#include "TG4MediumMap.h"
+#include "TG4Medium.h"
+#include "TG4Globals.h"
+
+#include <G4Track.hh>
+#include <G4VProcess.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+#include <G4SystemOfUnits.hh>
+
+//_____________________________________________________________________________
+TG4TrackSavePolicy::TG4TrackSavePolicy()
+  : fMessenger(this),
+    fMinEkin(0.),
+    fProcessNames(),
+    fMediumNames(),
+    fRegionNames(),
+    fMediumIds(),
+    fRegions(),
+    fSelection(0),
+    fSaveOnSDHit(false),
+    fHasCriteria(false),
+    fIsResolved(false)
+{
+/// Default constructor
+}
+
+//_____________________________________________________________________________
+TG4TrackSavePolicy::~TG4TrackSavePolicy()
+{
+/// Destructor
+/// (the user selection is not deleted)
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::Resolve()
+{
+/// Convert the media and regions names in their IDs and objects;
+/// this can be done only after the geometry is built.
+
+  fMediumIds.clear();
+  if ( fMediumNames.size() ) {
+    TG4MediumMap* mediumMap = TG4GeometryServices::Instance()->GetMediumMap();
+    for ( auto& mediumName : fMediumNames ) {
+      TG4Medium* medium = mediumMap->GetMedium(mediumName, false);
+      if ( ! medium ) {
+        TG4Globals::Warning(
+          "TG4TrackSavePolicy", "Resolve",
+          "Medium " + TString(mediumName) + " not found.");
+        continue;
+      }
+      fMediumIds.insert(medium->GetID());
+    }
+  }
+
+  fRegions.clear();
+  for ( auto& regionName : fRegionNames ) {
+    G4Region* region 
+      = G4RegionStore::GetInstance()->GetRegion(regionName, false);
+    if ( ! region ) {
+      TG4Globals::Warning(
+        "TG4TrackSavePolicy", "Resolve",
+        "Region " + TString(regionName) + " not found.");
+      continue;
+    }
+    fRegions.insert(region);
+  }
+
+  fIsResolved = true;
+}
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::UpdateHasCriteria()
+{
+/// Update the info whether any selection criterion is set
+
+  fHasCriteria 
+    = fMinEkin > 0. || fProcessNames.size() || fMediumNames.size() ||
+      fRegionNames.size() || fSelection;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+G4bool TG4TrackSavePolicy::Select(const G4Track* track)
+{
+/// Return true if the track passes all selection criteria;
+/// the track properties are evaluated at the vertex, and so this function 
+/// must be called either before the track starts or when it is created.
+/// If there is no selection criterion set, no track is selected.
+
+  if ( ! fHasCriteria ) return false;
+
+  if ( ! fIsResolved ) Resolve();
+
+  // kinetic energy
+  if ( track->GetKineticEnergy() < fMinEkin ) return false;
+
+  // creator process
+  if ( fProcessNames.size() ) {
+    const G4VProcess* process = track->GetCreatorProcess();
+    if ( ! process || 
+         fProcessNames.find(process->GetProcessName()) == fProcessNames.end() ) 
+      return false;
+  }
+
+  // vertex volume medium and region
+  if ( fMediumNames.size() || fRegionNames.size() ) {
+    G4VPhysicalVolume* pv = track->GetVolume();
+    if ( ! pv ) return false;
+    G4LogicalVolume* lv = pv->GetLogicalVolume();
+
+    if ( fMediumNames.size() &&
+         fMediumIds.find(TG4GeometryServices::Instance()->GetMediumId(lv)) 
+           == fMediumIds.end() ) return false;
+
+    if ( fRegionNames.size() &&
+         fRegions.find(lv->GetRegion()) == fRegions.end() ) return false;
+  }
+
+  // user selection
+  if ( fSelection && ! fSelection->Select(track) ) return false;
+
+  return true;
+}
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::Print() const
+{
+/// Print the policy criteria
+
+  G4cout << "Track save policy: ";
+  if ( ! IsActive() ) {
+    G4cout << "not active (all tracks are saved)" << G4endl;
+    return;
+  }
+  G4cout << G4endl;
+
+  if ( fMinEkin > 0. ) {
+    G4cout << "  minimum kinetic energy: " << fMinEkin/MeV << " MeV" << G4endl;
+  }
+
+  if ( fProcessNames.size() ) {
+    G4cout << "  processes:";
+    for ( auto& name : fProcessNames ) G4cout << " " << name;
+    G4cout << G4endl;
+  }
+
+  if ( fMediumNames.size() ) {
+    G4cout << "  media:";
+    for ( auto& name : fMediumNames ) G4cout << " " << name;
+    G4cout << G4endl;
+  }
+
+  if ( fRegionNames.size() ) {
+    G4cout << "  regions:";
+    for ( auto& name : fRegionNames ) G4cout << " " << name;
+    G4cout << G4endl;
+  }
+
+  if ( fSelection ) {
+    G4cout << "  user selection set" << G4endl;
+  }
+
+  if ( fSaveOnSDHit ) {
+    G4cout << "  tracks not selected are saved on SD hit" << G4endl;
+  }
+}
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::Reset()
+{
+/// Remove all criteria and deactivate the policy
+/// (the user selection is not deleted)
+
+  fMinEkin = 0.;
+  fProcessNames.clear();
+  fMediumNames.clear();
+  fRegionNames.clear();
+  fMediumIds.clear();
+  fRegions.clear();
+  fSelection = 0;
+  fSaveOnSDHit = false;
+  fHasCriteria = false;
+  fIsResolved = false;
+}
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::SetMinEkin(G4double minEkin)
+{
+/// Set the kinetic energy threshold (in the Geant4 units)
+
+  fMinEkin = minEkin;
+  UpdateHasCriteria();
+}
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::AddProcess(const G4String& processName)
+{
+/// Add the (Geant4) process name to the selected creator processes
+
+  fProcessNames.insert(processName);
+  UpdateHasCriteria();
+}
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::AddMedium(const G4String& mediumName)
+{
+/// Add the medium name to the selected vertex media
+
+  fMediumNames.insert(mediumName);
+  fIsResolved = false;
+  UpdateHasCriteria();
+}
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::AddRegion(const G4String& regionName)
+{
+/// Add the region name to the selected vertex regions
+
+  fRegionNames.insert(regionName);
+  fIsResolved = false;
+  UpdateHasCriteria();
+}
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::SetSaveOnSDHit(G4bool saveOnSDHit)
+{
+/// Set the option to save the tracks, which were not selected,
+/// when they make a step in a sensitive detector
+
+  fSaveOnSDHit = saveOnSDHit;
+}
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicy::SetSelection(TG4VTrackSelection* selection)
+{
+/// Set the user selection; it is not deleted by this class
+
+  fSelection = selection;
+  UpdateHasCriteria();
+}
@@ -0,0 +1,138 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4TrackSavePolicyMessenger.cxx
+/// \brief Implementation of the TG4TrackSavePolicyMessenger class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4TrackSavePolicyMessenger.h"
+#include "TG4TrackSavePolicy.h"
+
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithADoubleAndUnit.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithoutParameter.hh>
+
+//_____________________________________________________________________________
+TG4TrackSavePolicyMessenger::TG4TrackSavePolicyMessenger(
+                               TG4TrackSavePolicy* savePolicy)
+  : G4UImessenger(),
+    fSavePolicy(savePolicy),
+    fDirectory(0),
+    fMinEkinCmd(0),
+    fAddProcessCmd(0),
+    fAddMediumCmd(0),
+    fAddRegionCmd(0),
+    fSaveOnSDHitCmd(0),
+    fResetCmd(0),
+    fPrintCmd(0)
+{
+/// Standard constructor
+
+  fDirectory = new G4UIdirectory("/mcTracking/savePolicy/");
+  fDirectory->SetGuidance("Policy for selecting secondaries saved in the VMC stack.");
+  fDirectory->SetGuidance("A secondary is saved if it passes all defined criteria;");
+  fDirectory->SetGuidance("the tracks not saved are attributed to their nearest saved ancestor.");
+
+  fMinEkinCmd 
+    = new G4UIcmdWithADoubleAndUnit("/mcTracking/savePolicy/minEkin", this);
+  fMinEkinCmd->SetGuidance("Save only secondaries with kinetic energy above this threshold");
+  fMinEkinCmd->SetParameterName("MinEkin", false);
+  fMinEkinCmd->SetDefaultUnit("MeV");
+  fMinEkinCmd->SetRange("MinEkin >= 0.");
+  fMinEkinCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fAddProcessCmd 
+    = new G4UIcmdWithAString("/mcTracking/savePolicy/addProcess", this);
+  fAddProcessCmd->SetGuidance("Save only secondaries created by the given (Geant4) processes.");
+  fAddProcessCmd->SetGuidance("The command can be applied more times.");
+  fAddProcessCmd->SetParameterName("ProcessName", false);
+  fAddProcessCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fAddMediumCmd 
+    = new G4UIcmdWithAString("/mcTracking/savePolicy/addMedium", this);
+  fAddMediumCmd->SetGuidance("Save only secondaries created in the given media.");
+  fAddMediumCmd->SetGuidance("The command can be applied more times.");
+  fAddMediumCmd->SetParameterName("MediumName", false);
+  fAddMediumCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fAddRegionCmd 
+    = new G4UIcmdWithAString("/mcTracking/savePolicy/addRegion", this);
+  fAddRegionCmd->SetGuidance("Save only secondaries created in the given regions.");
+  fAddRegionCmd->SetGuidance("The command can be applied more times.");
+  fAddRegionCmd->SetParameterName("RegionName", false);
+  fAddRegionCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fSaveOnSDHitCmd 
+    = new G4UIcmdWithABool("/mcTracking/savePolicy/saveOnSDHit", this);
+  fSaveOnSDHitCmd->SetGuidance("Save the secondaries which were not selected");
+  fSaveOnSDHitCmd->SetGuidance("when they make a step in a sensitive detector.");
+  fSaveOnSDHitCmd->SetParameterName("SaveOnSDHit", false);
+  fSaveOnSDHitCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fResetCmd 
+    = new G4UIcmdWithoutParameter("/mcTracking/savePolicy/reset", this);
+  fResetCmd->SetGuidance("Remove all criteria and deactivate the policy.");
+  fResetCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fPrintCmd 
+    = new G4UIcmdWithoutParameter("/mcTracking/savePolicy/print", this);
+  fPrintCmd->SetGuidance("Print the track save policy criteria.");
+  fPrintCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+}
+
+//_____________________________________________________________________________
+TG4TrackSavePolicyMessenger::~TG4TrackSavePolicyMessenger() 
+{
+/// Destructor
+
+  delete fDirectory;
+  delete fMinEkinCmd;
+  delete fAddProcessCmd;
+  delete fAddMediumCmd;
+  delete fAddRegionCmd;
+  delete fSaveOnSDHitCmd;
+  delete fResetCmd;
+  delete fPrintCmd;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4TrackSavePolicyMessenger::SetNewValue(G4UIcommand* command, 
+       G4String newValue)
+{ 
+/// Apply command to the associated object.
+
+  if(command == fMinEkinCmd) { 
+    fSavePolicy->SetMinEkin(fMinEkinCmd->GetNewDoubleValue(newValue)); 
+  }   
+  else if(command == fAddProcessCmd) { 
+    fSavePolicy->AddProcess(newValue); 
+  }   
+  else if(command == fAddMediumCmd) { 
+    fSavePolicy->AddMedium(newValue); 
+  }   
+  else if(command == fAddRegionCmd) { 
+    fSavePolicy->AddRegion(newValue); 
+  }   
+  else if(command == fSaveOnSDHitCmd) { 
+    fSavePolicy->SetSaveOnSDHit(fSaveOnSDHitCmd->GetNewBoolValue(newValue)); 
+  }   
+  else if(command == fResetCmd) { 
+    fSavePolicy->Reset(); 
+  }   
+  else if(command == fPrintCmd) { 
+    fSavePolicy->Print(); 
+  }   
+}
@@ -19,16 +19,20 @@
 #include "TG4PhysicsManager.h"
 #include "TG4ParticlesManager.h"
 #include "TG4StackPopper.h"
+#include "TG4SteppingAction.h"
+#include "TG4StepProfiler.h"
 #include "TG4SensitiveDetector.h"
 #include "TG4GeometryServices.h"
 #include "TG4SDServices.h"
 #include "TG4SpecialControlsV2.h"
+#include "TG4CallbackTimer.h"
 #include "TG4Globals.h"
 
 #include <TVirtualMC.h>
 #include <TVirtualMCApplication.h>
 #include <TVirtualMC.h>
 #include <TMCProcess.h>
+#include <TVirtualMCStackWithKeepFlag.h>
 
 #include <G4TrackVector.hh>
 #include <G4TrackingManager.hh>
@@ -48,6 +52,7 @@ TG4TrackingAction::TG4TrackingAction()
     fMCStack(0),
     fStepManager(0),
     fStackPopper(0),
+    fStepProfiler(0),
     fPrimaryTrackID(0),
     fCurrentTrackID(0),
     fTrackSaveControl(kDoNotSave),
@@ -83,7 +88,7 @@ TG4TrackingAction::~TG4TrackingAction()
 //
 
 //_____________________________________________________________________________
-void TG4TrackingAction::UserProcessHits(const G4Track* /*track*/)
+void TG4TrackingAction::UserProcessHits(const G4Track* track)
 {
 /// Let sensitive detector process the vertex step
 /// (this ensures compatibility with G3 that
@@ -103,14 +108,14 @@ void TG4TrackingAction::UserProcessHits(const G4Track* /*track*/)
     = TG4SDServices::Instance()
          ->GetSensitiveDetector(
               pv->GetLogicalVolume()->GetSensitiveDetector());
-
-  if (tsd) tsd->ProcessHitsOnTrackStart();
 #else
   TG4SensitiveDetector* tsd
     = (TG4SensitiveDetector*) pv->GetLogicalVolume()->GetSensitiveDetector();
-
-  if (tsd) tsd->ProcessHitsOnTrackStart();
 #endif  
+
+  if ( ! tsd ) return;
+
+  tsd->ProcessHitsOnTrackStart();
 }
 
 //_____________________________________________________________________________
@@ -139,6 +144,8 @@ void TG4TrackingAction::LateInitialize()
   fMCApplication = TVirtualMCApplication::Instance();
   fStepManager = TG4StepManager::Instance();
   fStackPopper = TG4StackPopper::Instance();
+  if ( TG4SteppingAction::Instance() ) 
+    fStepProfiler = &TG4SteppingAction::Instance()->GetStepProfiler();
 
   fTrackManager->LateInitialize();
 }
@@ -160,6 +167,9 @@ void TG4TrackingAction::PrepareNewEvent()
     fTrackManager->SetNofTracks(fMCStack->GetNtrack());
     
   fCurrentTrackID = 0;
+  fOverwriteLastTrack = false;
+
+  if ( fStackPopper ) fStackPopper->ResetNofPoppedTracks();
 }
 
 //_____________________________________________________________________________
@@ -191,9 +201,24 @@ void TG4TrackingAction::PreUserTrackingAction(const G4Track* track)
     fStepManager->SetStep((G4Track*)track, kVertex);
   }  
   
+  // the track save policy is applied (once) to a new secondary track 
+  // which is going to be saved in pre-track
+  G4bool isSavedInPreTrack
+    =  isFirstStep && track->GetParentID() != 0 &&
+       fTrackManager->GetTrackSaveControl() == kSaveInPreTrack &&
+     ! fTrackManager->IsUserTrack(track);
+  TG4TrackSavePolicy& savePolicy = fTrackManager->GetTrackSavePolicy();
+  G4bool isSelected 
+    = ! isSavedInPreTrack || ! savePolicy.IsActive() || savePolicy.Select(track);
+
+  // the last track in the stack can be overwritten only with
+  // a new secondary track which is going to be saved in pre-track
+  G4bool overWrite = fOverwriteLastTrack && isSavedInPreTrack && isSelected;
+  fOverwriteLastTrack = false;       
+
   // set track information
   G4int trackId 
-    = fTrackManager->SetTrackInformation(track, fOverwriteLastTrack);
+    = fTrackManager->SetTrackInformation(track, overWrite);
   fMCStack->SetCurrentTrack(trackId);
 
   if ( isFirstStep ) {
@@ -201,7 +226,12 @@ void TG4TrackingAction::PreUserTrackingAction(const G4Track* track)
       fPrimaryTrackID = track->GetTrackID();
     
       // begin this primary track
-      fMCApplication->BeginPrimary();
+      {
+#ifdef USE_CALLBACK_TIMING
+        TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kBeginPrimary);
+#endif
+        fMCApplication->BeginPrimary();
+      }
     
       // set saving flag
       fTrackSaveControl = kDoNotSave;
@@ -214,10 +244,17 @@ void TG4TrackingAction::PreUserTrackingAction(const G4Track* track)
    
     // save track in stack
     if ( fTrackSaveControl == kSaveInPreTrack ) {
-      fTrackManager->TrackToStack(track, fOverwriteLastTrack);
-
-      // Notify a stack popper (if activated) about saving this secondary
-      if ( fStackPopper ) fStackPopper->Notify();
+      if ( ! isSelected ) {
+        // the track is not selected: attribute it to its saved ancestor 
+        trackId = fTrackManager->DropTrack(track);
+        fMCStack->SetCurrentTrack(trackId);
+      }
+      else {  
+        fTrackManager->TrackToStack(track, overWrite);
+
+        // Notify a stack popper (if activated) about saving this secondary
+        if ( fStackPopper ) fStackPopper->Notify();
+      }  
     }
   }      
 
@@ -228,7 +265,12 @@ void TG4TrackingAction::PreUserTrackingAction(const G4Track* track)
 
   // VMC application pre track action
   if ( isFirstStep ) {
-    fMCApplication->PreTrack();
+    {
+#ifdef USE_CALLBACK_TIMING
+      TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kPreTrack);
+#endif
+      fMCApplication->PreTrack();
+    }
   
     // call pre-tracking action of derived class
     PreTrackingAction(track);
@@ -236,6 +278,10 @@ void TG4TrackingAction::PreUserTrackingAction(const G4Track* track)
     // Let sensitive detector process vertex step
     UserProcessHits(track);
   }  
+
+  // start timing of the first step if profiling is activated
+  if ( fStepProfiler && TG4StepProfiler::IsActive() ) 
+    fStepProfiler->StartStep();
 }
 
 //_____________________________________________________________________________
@@ -243,20 +289,23 @@ void TG4TrackingAction::PostUserTrackingAction(const G4Track* track)
 {
 /// Called by G4 kernel after finishing tracking.
 
-#ifdef STACK_WITH_KEEP_FLAG  
-  // Remember whether this track should be kept in the stack
-  // or can be overwritten:
-  // the track will not be overwritten if it was flagged in the stack
-  // to be kept or if it has produced any secondary particles.  
-  fOverwriteLastTrack
-    =  ( ! fMCStack->GetKeepCurrentTrack() ) &&
-       ( ! fpTrackingManager->GimmeSecondaries() ||
-           fpTrackingManager->GimmeSecondaries()->size() == 0 );
-        // Experimental code with flagging tracks in stack for overwrite; 
-        // not yet available in distribution
-#else        
+  // Remember whether this track can be overwritten in the stack
+  // by the next track (see TVirtualMCStackWithKeepFlag):
+  // the track can be overwritten only if it is a finished secondary track 
+  // saved as the last track in the stack, it has not produced any secondary 
+  // particles and it was not flagged in the stack to be kept
   fOverwriteLastTrack = false;       
-#endif 
+  if ( fTrackManager->IsOverwriteTracks() &&
+       track->GetTrackStatus() != fSuspend && track->GetParentID() != 0 ) {
+    TG4TrackInformation* trackInfo = fTrackManager->GetTrackInformation(track);
+    fOverwriteLastTrack
+      =  ( ! trackInfo->IsUserTrack() ) &&
+         ( ! trackInfo->IsDropped() ) &&
+         ( trackInfo->GetTrackParticleID() == fMCStack->GetNtrack() - 1 ) &&
+         ( ! fTrackManager->GetKeepFlagMCStack()->GetKeepCurrentTrack() ) &&
+         ( ! fpTrackingManager->GimmeSecondaries() ||
+             fpTrackingManager->GimmeSecondaries()->size() == 0 );
+  }  
  
   // restore processes activation 
   if ( fSpecialControls && fSpecialControls->IsApplicable() ) 
@@ -275,7 +324,12 @@ void TG4TrackingAction::PostUserTrackingAction(const G4Track* track)
   if ( track->GetTrackStatus() != fSuspend ) {
 
     // VMC application post track action
-    fMCApplication->PostTrack();
+    {
+#ifdef USE_CALLBACK_TIMING
+      TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kPostTrack);
+#endif
+      fMCApplication->PostTrack();
+    }
 
     // call post-tracking action of derived class
     PostTrackingAction(track);
@@ -301,7 +355,12 @@ void TG4TrackingAction::FinishPrimaryTrack()
     Verbose();
 
     // VMC application finish primary track       
-    fMCApplication->FinishPrimary();
+    {
+#ifdef USE_CALLBACK_TIMING
+      TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kFinishPrimary);
+#endif
+      fMCApplication->FinishPrimary();
+    }
   }
   
   fPrimaryTrackID = 0;
@@ -15,6 +15,7 @@
 #include "TG4TrackingActionMessenger.h"
 #include "TG4TrackingAction.h"
 #include "TG4TrackManager.h"
+#include "TG4TrackInformation.h"
 #include "TG4Globals.h"
 
 #include <G4UIdirectory.hh>
@@ -31,7 +32,9 @@ TG4TrackingActionMessenger::TG4TrackingActionMessenger(
     fNewVerboseCmd(0),
     fNewVerboseTrackCmd(0),
     fSaveSecondariesCmd(0),
-    fSaveDynamicChargeCmd(0)
+    fSaveDynamicChargeCmd(0),
+    fOverwriteTracksCmd(0),
+    fTrackInfoPageFactorCmd(0)
 {
 /// Standard constructor
 
@@ -66,6 +69,27 @@ TG4TrackingActionMessenger::TG4TrackingActionMessenger(
   fSaveDynamicChargeCmd->SetGuidance("(The dynamic charge is not saved by default.)");
   fSaveDynamicChargeCmd->SetParameterName("SaveDynamicCharge", false);
   fSaveDynamicChargeCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fOverwriteTracksCmd = new G4UIcmdWithABool("/mcTracking/overwriteTracks", this);
+  fOverwriteTracksCmd
+    ->SetGuidance("Option for overwriting the last track in the stack with the next secondary");
+  fOverwriteTracksCmd
+    ->SetGuidance("if the last track has finished, has no secondaries and was not flagged to be kept.");
+  fOverwriteTracksCmd
+    ->SetGuidance("It is applied only if the stack implements TVirtualMCStackWithKeepFlag.");
+  fOverwriteTracksCmd->SetGuidance("(The tracks are not overwritten by default.)");
+  fOverwriteTracksCmd->SetParameterName("OverwriteTracks", false);
+  fOverwriteTracksCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fTrackInfoPageFactorCmd 
+    = new G4UIcmdWithAnInteger("/mcTracking/trackInfoPageFactor", this);
+  fTrackInfoPageFactorCmd
+    ->SetGuidance("Set the factor increasing the page size of the track information allocator.");
+  fTrackInfoPageFactorCmd
+    ->SetGuidance("Larger pages reduce the number of allocations in events with many secondaries.");
+  fTrackInfoPageFactorCmd->SetParameterName("TrackInfoPageFactor", false);
+  fTrackInfoPageFactorCmd->SetRange("TrackInfoPageFactor >= 1");
+  fTrackInfoPageFactorCmd->AvailableForStates(G4State_PreInit);
 }
 
 //_____________________________________________________________________________
@@ -78,6 +102,8 @@ TG4TrackingActionMessenger::~TG4TrackingActionMessenger()
   delete fNewVerboseTrackCmd;
   delete fSaveSecondariesCmd;
   delete fSaveDynamicChargeCmd;
+  delete fOverwriteTracksCmd;
+  delete fTrackInfoPageFactorCmd;
 }
 
 //
@@ -110,4 +136,12 @@ void TG4TrackingActionMessenger::SetNewValue(G4UIcommand* command,
     TG4TrackManager::Instance()->SetSaveDynamicCharge(
                                    fSaveDynamicChargeCmd->GetNewBoolValue(newValue));
   }   
+  else if(command == fOverwriteTracksCmd) { 
+    TG4TrackManager::Instance()->SetOverwriteTracks(
+                                   fOverwriteTracksCmd->GetNewBoolValue(newValue));
+  }   
+  else if(command == fTrackInfoPageFactorCmd) { 
+    TG4TrackInformation::SetAllocatorPageFactor(
+                           fTrackInfoPageFactorCmd->GetNewIntValue(newValue));
+  }   
 }
@@ -0,0 +1,27 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4VTrackSelection.cxx
+/// \brief Implementation of the TG4VTrackSelection class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4VTrackSelection.h"
+
+//_____________________________________________________________________________
+TG4VTrackSelection::TG4VTrackSelection()
+{
+/// Default constructor
+}
+
+//_____________________________________________________________________________
+TG4VTrackSelection::~TG4VTrackSelection()
+{
+/// Destructor
+}
@@ -15,6 +15,7 @@
 #include "TG4GeometryManager.h"
 #include "TG4GeometryServices.h"
 #include "TG4SDManager.h"
+#include "TG4SDServices.h"
 #include "TG4MCGeometry.h"
 #include "TG4OpGeometryManager.h"
 #include "TG4ModelConfigurationManager.h"
@@ -841,6 +842,9 @@ void TG4GeometryManager::FinishGeometry()
   fGeometryServices->SetWorld(
     G4TransportationManager::GetTransportationManager()
       ->GetNavigatorForTracking()->GetWorldVolume());
+
+  // Fill volume descriptors used by step manager
+  TG4SDServices::Instance()->MapVolumeDescriptors();
     
   if ( VerboseLevel() > 1 ) 
     G4cout << "TG4GeometryManager::FinishGeometry done" << G4endl;
@@ -0,0 +1,109 @@
+#ifndef TG4_CALLBACK_TIMER_H
+#define TG4_CALLBACK_TIMER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4CallbackTimer.h
+/// \brief Definition of the TG4CallbackTimer class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#ifdef USE_CALLBACK_TIMING
+
+#include <globals.hh>
+
+#include <chrono>
+
+/// \ingroup global
+/// \brief The timer of the calls to the user VMC application and 
+/// user sensitive detectors
+///
+/// The call counts and the elapsed clock ticks are accumulated per 
+/// callback type in thread-local counters, they are merged 
+/// at the end of run and printed by the master TG4RunAction together 
+/// with the run time.
+///
+/// The timing is available only when Geant4 VMC is built with
+/// the Geant4VMC_USE_CALLBACK_TIMING option; otherwise the class and 
+/// all its calls are compiled out.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4CallbackTimer
+{
+  public:
+    /// The timed user callbacks
+    enum ECallback {
+      kBeginEvent,          ///< TVirtualMCApplication::BeginEvent()
+      kGeneratePrimaries,   ///< TVirtualMCApplication::GeneratePrimaries()
+      kBeginPrimary,        ///< TVirtualMCApplication::BeginPrimary()
+      kPreTrack,            ///< TVirtualMCApplication::PreTrack()
+      kStepping,            ///< TVirtualMCApplication::Stepping()
+      kSDProcessHits,       ///< TVirtualMCSensitiveDetector::ProcessHits()
+      kSteppingAction,      ///< TG4SteppingAction::SteppingAction()
+      kPostTrack,           ///< TVirtualMCApplication::PostTrack()
+      kFinishPrimary,       ///< TVirtualMCApplication::FinishPrimary()
+      kSDEndOfEvent,        ///< TVirtualMCSensitiveDetector::EndOfEvent()
+      kFinishEvent,         ///< TVirtualMCApplication::FinishEvent()
+      kNofCallbacks         ///< the number of callback types
+    };
+
+    /// The guard which times the callback called in its scope
+    class Guard
+    {
+      public:
+        /// Standard constructor
+        Guard(ECallback callback) 
+          : fCallback(callback), 
+            fStart(std::chrono::steady_clock::now()) {}
+        /// Destructor
+        ~Guard() { 
+          TG4CallbackTimer::Add(
+            fCallback, (std::chrono::steady_clock::now() - fStart).count()); }
+      private:
+        ECallback  fCallback; ///< the timed callback
+        std::chrono::steady_clock::time_point  fStart; ///< the start time 
+    };
+
+    // static methods
+    static void Add(ECallback callback, G4long ticks);
+    static void Merge();
+    static void Print(G4double runTime);
+    static void Clear();
+
+  private:
+    /// Not implemented
+    TG4CallbackTimer();
+
+    // static data members
+    /// the names of callbacks
+    static const char* fgkCallbackNames[kNofCallbacks];
+    /// the thread-local call counts
+    static G4ThreadLocal G4long fgNofCalls[kNofCallbacks];
+    /// the thread-local clock ticks
+    static G4ThreadLocal G4long fgTicks[kNofCallbacks];
+    /// the merged call counts
+    static G4long fgMergedNofCalls[kNofCallbacks];
+    /// the merged clock ticks
+    static G4long fgMergedTicks[kNofCallbacks];
+};
+
+// inline methods
+
+inline void TG4CallbackTimer::Add(ECallback callback, G4long ticks) {
+  /// Add the call and its clock ticks to the thread-local counters
+  ++fgNofCalls[callback];
+  fgTicks[callback] += ticks;
+}
+
+#endif //USE_CALLBACK_TIMING
+
+#endif //TG4_CALLBACK_TIMER_H
+
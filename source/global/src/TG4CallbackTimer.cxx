@@ -0,0 +1,103 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4CallbackTimer.cxx
+/// \brief Implementation of the TG4CallbackTimer class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4CallbackTimer.h"
+
+#ifdef USE_CALLBACK_TIMING
+
+#include "TG4Globals.h"
+
+#include <G4AutoLock.hh>
+
+#include <iomanip>
+
+// mutex in a file scope
+
+#ifdef G4MULTITHREADED
+namespace {
+  //Mutex to lock the merged counters
+  G4Mutex mergeMutex = G4MUTEX_INITIALIZER;
+}
+#endif
+
+// static data members
+const char* TG4CallbackTimer::fgkCallbackNames[kNofCallbacks] = {
+  "BeginEvent", "GeneratePrimaries", "BeginPrimary", "PreTrack", 
+  "Stepping", "SD::ProcessHits", "SteppingAction", "PostTrack",
+  "FinishPrimary", "SD::EndOfEvent", "FinishEvent" };
+G4ThreadLocal G4long TG4CallbackTimer::fgNofCalls[kNofCallbacks] = { 0 };
+G4ThreadLocal G4long TG4CallbackTimer::fgTicks[kNofCallbacks] = { 0 };
+G4long TG4CallbackTimer::fgMergedNofCalls[kNofCallbacks] = { 0 };
+G4long TG4CallbackTimer::fgMergedTicks[kNofCallbacks] = { 0 };
+
+//_____________________________________________________________________________
+void TG4CallbackTimer::Merge()
+{
+/// Merge the thread-local counters in the merged ones and reset them
+
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&mergeMutex);
+#endif
+
+  for ( G4int i=0; i<kNofCallbacks; ++i ) {
+    fgMergedNofCalls[i] += fgNofCalls[i];
+    fgMergedTicks[i] += fgTicks[i];
+    fgNofCalls[i] = 0;
+    fgTicks[i] = 0;
+  }
+}
+
+//_____________________________________________________________________________
+void TG4CallbackTimer::Print(G4double runTime)
+{
+/// Print the merged counters and the time fraction with respect to 
+/// the given run time (in s); reset the merged counters afterwards.
+/// Note that in MT mode the callbacks time is summed over all threads.
+
+  typedef std::chrono::steady_clock::period Period;
+  const G4double kTickToSecond = G4double(Period::num)/Period::den;
+
+  G4double totalTime = 0.;
+  G4cout << "Time in user callbacks: " << G4endl;
+  for ( G4int i=0; i<kNofCallbacks; ++i ) {
+    if ( ! fgMergedNofCalls[i] ) continue;
+
+    G4double time = fgMergedTicks[i]*kTickToSecond;
+    totalTime += time;
+    G4cout << "  " << std::left << std::setw(20) << fgkCallbackNames[i]
+           << std::right << std::setw(14) << fgMergedNofCalls[i] << " calls "
+           << std::setw(12) << time << " s" << G4endl;
+  }
+  G4cout << "  " << std::left << std::setw(20) << "Total" << std::right
+         << std::setw(33) << totalTime << " s";
+  if ( runTime > 0. ) {
+    G4cout << "  (" << totalTime/runTime*100. << " % of run real time)";
+  }
+  G4cout << G4endl;
+
+  Clear();
+}
+
+//_____________________________________________________________________________
+void TG4CallbackTimer::Clear()
+{
+/// Reset the merged counters
+
+  for ( G4int i=0; i<kNofCallbacks; ++i ) {
+    fgMergedNofCalls[i] = 0;
+    fgMergedTicks[i] = 0;
+  }
+}
+
+#endif //USE_CALLBACK_TIMING
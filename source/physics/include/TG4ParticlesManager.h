@@ -28,6 +28,7 @@
 #include <TMCParticleType.h>
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 class G4DynamicParticle;
@@ -100,6 +101,10 @@ class TG4ParticlesManager : public TG4Verbose
     TG4UserParticle*  GetUserParticle(G4int index) const;
     
   private:
+    /// The map of resolved PDG encodings per particle definition
+    typedef std::unordered_map<const G4ParticleDefinition*, G4int>
+      PDGEncodingMap;
+
     /// Not implemented
     TG4ParticlesManager(const TG4ParticlesManager& right);
     /// Not implemented
@@ -109,9 +114,15 @@ class TG4ParticlesManager : public TG4Verbose
     // G4int GetPDGIonEncoding(G4int Z, G4int A, G4int iso) const;
     void  AddParticleToPdgDatabase(const G4String& name,
                               G4ParticleDefinition* particleDefinition);  
+    G4int ResolvePDGEncoding(G4ParticleDefinition* particle);
 
     // static data members
     static TG4ParticlesManager*  fgInstance; ///< this instance
+
+    /// \brief the thread-local cache of resolved PDG encodings 
+    /// indexed by the particle definition
+    /// (not by its ID which is shared by all general ions)
+    static G4ThreadLocal PDGEncodingMap*  fgPDGEncodings;
     
     //
     // data members
@@ -99,7 +99,10 @@ class TG4PhysicsManager : public TG4Verbose
     void  DefineParticles();      
     void  SetProcessActivation();  
     void  RetrieveOpBoundaryProcess();  
+    void  CacheProcesses();
     TMCProcess GetMCProcess(const G4VProcess* process);
+    G4bool IsTransportation(const G4VProcess* process) const;
+    G4bool IsMuPairProd(const G4VProcess* process) const;
     TMCProcess GetOpBoundaryStatus();
 
     void SetCutForGamma(G4double cut);
@@ -219,6 +222,16 @@ inline G4double TG4PhysicsManager::GetCutForProton() const {
   return fCutForProton;
 }
 
+inline G4bool TG4PhysicsManager::IsTransportation(const G4VProcess* process) const {
+  /// Return true if the given process is the transportation process
+  return fgProcessMCMap->IsTransportation(process);
+}
+
+inline G4bool TG4PhysicsManager::IsMuPairProd(const G4VProcess* process) const {
+  /// Return true if the given process is the muon pair production process
+  return fgProcessMCMap->IsMuPairProd(process);
+}
+
 inline G4bool TG4PhysicsManager::IsOpBoundaryProcess() const {
   /// Return true if optical boundary process is defined
   return ( fOpBoundaryProcess != 0 );
@@ -16,6 +16,7 @@
 /// \author I. Hrivnacova; IPN Orsay
 
 #include <map>
+#include <unordered_map>
 #include <globals.hh>
 
 #include <Rtypes.h>
@@ -29,6 +30,13 @@ class G4VProcess;
 /// Singleton map container for associated pairs
 /// of G4 process name and TMCProcess code.
 ///
+/// The codes are also cached per thread in a map keyed by the G4 process
+/// pointer, together with the process flags used at the step level,
+/// so that no string comparison is done during tracking.
+/// The cache is filled with all processes when physics is built
+/// (see CacheProcesses()) and it is completed lazily for processes
+/// added later.
+///
 /// \author I. Hrivnacova; IPN Orsay
 
 class TG4ProcessMCMap
@@ -43,6 +51,18 @@ class TG4ProcessMCMap
     /// The constant iterator for the map of TMCProcess to strings
     typedef Map::const_iterator  MapConstIterator;
 
+    /// The process flags kept in the process cache
+    enum EProcessFlag {
+      kIsTransportation = 1, ///< the "Transportation" process
+      kIsMuPairProd     = 2  ///< the "muPairProd" process
+    };
+
+    /// The process data kept in the process cache (TMCProcess code, flags)
+    typedef std::pair<TMCProcess, G4int>  ProcessData;
+
+    /// The map of G4 processes to their cached data
+    typedef std::unordered_map<const G4VProcess*, ProcessData>  ProcessDataMap;
+
   public:
     TG4ProcessMCMap();
     virtual ~TG4ProcessMCMap();
@@ -55,12 +75,15 @@ class TG4ProcessMCMap
     G4bool Add(G4String processName, TMCProcess second);  
     void PrintAll() const;
     void Clear();
+    void CacheProcesses();
 
     // get methods
     TMCProcess  GetMCProcess(const G4VProcess* process) const;
     TMCProcess  GetMCProcess(const G4String& processName) const;
     G4String    GetMCProcessName(const G4VProcess* process) const;
     G4String    GetMCProcessName(const G4String& processName) const;
+    G4bool      IsTransportation(const G4VProcess* process) const;
+    G4bool      IsMuPairProd(const G4VProcess* process) const;
 
   private:
     /// Not implemented
@@ -70,11 +93,16 @@ class TG4ProcessMCMap
   
     // methods
     G4bool IsDefined(const G4String& processName);
+    const ProcessData& GetProcessData(const G4VProcess* process) const;
+    const ProcessData& CacheProcess(const G4VProcess* process) const;
 
     // static data members
     // MT COMMON
     static TG4ProcessMCMap*  fgInstance; ///< this instance
 
+    /// the thread-local cache of process data
+    static G4ThreadLocal ProcessDataMap*  fgProcessDataMap;
+
     // data members
     Map  fMap; ///< map container
 };
@@ -86,4 +114,27 @@ inline TG4ProcessMCMap* TG4ProcessMCMap::Instance() {
   return fgInstance; 
 }
 
+inline const TG4ProcessMCMap::ProcessData&
+TG4ProcessMCMap::GetProcessData(const G4VProcess* process) const {
+  /// Return the cached process data; add the process in the cache
+  /// if it is not yet there
+  if ( fgProcessDataMap ) {
+    ProcessDataMap::const_iterator it = fgProcessDataMap->find(process);
+    if ( it != fgProcessDataMap->end() ) return it->second;
+  }
+  return CacheProcess(process);
+}
+
+inline G4bool TG4ProcessMCMap::IsTransportation(const G4VProcess* process) const {
+  /// Return true if the given process is the "Transportation" process
+  if ( ! process ) return false;
+  return ( GetProcessData(process).second & kIsTransportation );
+}
+
+inline G4bool TG4ProcessMCMap::IsMuPairProd(const G4VProcess* process) const {
+  /// Return true if the given process is the "muPairProd" process
+  if ( ! process ) return false;
+  return ( GetProcessData(process).second & kIsMuPairProd );
+}
+
 #endif //TG4_PROCESS_MC_MAP_H
@@ -0,0 +1,193 @@
+#ifndef TG4_RUSSIAN_ROULETTE_H
+#define TG4_RUSSIAN_ROULETTE_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RussianRoulette.h
+/// \brief Definition of the TG4RussianRoulette class 
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TG4G3ParticleWSP.h"
+
+#include <G4VProcess.hh>
+
+#include <map>
+#include <set>
+#include <vector>
+
+class TG4Limits;
+class TG4TrackManager;
+
+class G4Track;
+class G4LogicalVolume;
+
+/// \ingroup physics
+/// \brief The variance reduction process which plays Russian roulette
+/// with low energy particles.
+///
+/// When the kinetic energy of a track drops below the threshold of 
+/// the current medium, the track is killed with the probability 
+/// (1 - survivalProbability) and its weight is divided 
+/// by the survivalProbability if it survives. The roulette is played
+/// only once per track.                                                  \n
+/// The threshold is given by the medium kinetic energy cut for the 
+/// particle type (see TG4Limits) multiplied by the energy factor,
+/// and so no roulette is played in the media without cuts.
+/// The roulette can be restricted to selected media.
+///
+/// The number of played and killed tracks and the sums of the track weights
+/// before and after the roulette are accumulated per medium; the counters
+/// are merged in TG4RunAction::EndOfRunAction(), where they are printed,
+/// so that the conservation of the total weight can be verified.
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+class TG4RussianRoulette: public G4VProcess
+{
+  public:
+    /// The roulette statistics
+    struct Statistics {
+      Statistics() 
+        : fNofPlayed(0), fNofKilled(0), fWeightIn(0.), fWeightOut(0.) {}
+      G4long   fNofPlayed; ///< the number of tracks played
+      G4long   fNofKilled; ///< the number of killed tracks
+      G4double fWeightIn;  ///< the sum of weights before the roulette
+      G4double fWeightOut; ///< the sum of weights after the roulette
+    };
+
+  public:
+    TG4RussianRoulette(const G4String& processName = "russianRoulette");
+    virtual ~TG4RussianRoulette();
+    
+    // static methods
+    static TG4RussianRoulette* Instance();
+    static void PrintStatistics();
+    static void ClearStatistics();
+
+    // methods
+    void SetParticleWSP(const G4ParticleDefinition* particle, 
+                        TG4G3ParticleWSP particleWSP);
+    void Merge();
+
+    virtual G4double PostStepGetPhysicalInteractionLength(
+                           const G4Track& track,
+                           G4double previousStepSize,
+                           G4ForceCondition* condition);
+
+    virtual G4VParticleChange* PostStepDoIt(
+                                   const G4Track& track,
+                                   const G4Step& step);
+
+    // No operation in AlongStepDoIt and AtRestDoIt
+
+    virtual G4double AlongStepGetPhysicalInteractionLength(
+                           const G4Track& /*track*/,
+                           G4double  /*previousStepSize*/,
+                           G4double  /*currentMinimumStep*/,
+                           G4double& /*proposedSafety*/,
+                           G4GPILSelection* /*selection*/)  { return -1.0; }
+
+    virtual G4double AtRestGetPhysicalInteractionLength(
+                           const G4Track& /*track*/,
+                           G4ForceCondition* /*condition*/) { return -1.0; }
+
+    virtual G4VParticleChange* AlongStepDoIt(
+                                   const G4Track& /*track*/,
+                                   const G4Step& /*step*/) { return 0; }
+
+    virtual G4VParticleChange* AtRestDoIt(
+                                   const G4Track& /*track*/,
+                                   const G4Step& /*step*/) { return 0; }
+
+    // set methods
+    void SetEnergyFactor(G4double energyFactor);
+    void SetSurvivalProbability(G4double survivalProbability);
+    void SetMediumNames(const std::set<G4String>& mediumNames);
+
+  private:
+    /// Not implemented
+    TG4RussianRoulette(const TG4RussianRoulette& right);
+    /// Not implemented
+    TG4RussianRoulette& operator = (const TG4RussianRoulette& right);
+
+    // methods
+    G4double GetThreshold(const TG4Limits& limits, const G4Track& track) const;
+    G4int    GetMediumId(G4LogicalVolume* lv);
+    void     ResolveMedia();
+
+    // static data members
+    
+    /// this instance
+    static G4ThreadLocal TG4RussianRoulette*  fgInstance;
+
+    /// the merged statistics per medium name
+    static std::map<G4String, Statistics>  fgStatistics;
+
+    // data members
+
+    /// Cached pointer to thread-local track manager
+    TG4TrackManager*  fTrackManager;
+
+    /// The energy threshold factor applied to the medium cut
+    G4double  fEnergyFactor;
+
+    /// The survival probability
+    G4double  fSurvivalProbability;
+
+    /// The names of the media where the roulette is played (all if empty)
+    std::set<G4String>  fMediumNames;
+
+    /// The IDs of the media where the roulette is played 
+    std::set<G4int>  fMediumIds;
+
+    /// Info whether the medium names were resolved
+    G4bool  fIsResolved;
+
+    /// The particle types indexed by particle definition ID
+    std::vector<G4int>  fParticleWSPs;
+
+    /// The medium IDs cache indexed by logical volume instance ID
+    /// (-1 if not yet cached)
+    std::vector<G4int>  fLVMediumIds;
+
+    /// The medium ID of the track to be played in PostStepDoIt
+    G4int  fCurrentMediumId;
+
+    /// The thread-local statistics per medium ID
+    std::map<G4int, Statistics>  fStatistics;
+};
+
+// inline methods
+
+inline TG4RussianRoulette* TG4RussianRoulette::Instance() { 
+  /// Return this instance.
+  return fgInstance; 
+}
+
+inline void TG4RussianRoulette::SetEnergyFactor(G4double energyFactor) {
+  /// Set the energy threshold factor applied to the medium cut
+  fEnergyFactor = energyFactor;
+}
+
+inline void TG4RussianRoulette::SetSurvivalProbability(
+                                   G4double survivalProbability) {
+  /// Set the survival probability
+  fSurvivalProbability = survivalProbability;
+}
+
+inline void TG4RussianRoulette::SetMediumNames(
+                                   const std::set<G4String>& mediumNames) {
+  /// Set the names of the media where the roulette is played
+  fMediumNames = mediumNames;
+  fIsResolved = false;
+}
+
+#endif //TG4_RUSSIAN_ROULETTE_H
@@ -17,14 +17,25 @@
 
 #include <G4VProcess.hh>
 
+#include <map>
+
+class TG4ParticlesManager;
+
 class TVirtualMCStack;
+class TParticle;
 
 class G4Track;
+class G4ParticleDefinition;
 
 /// \ingroup physics
 /// \brief The process which pops particles defined by user from 
 ///        the VMC stack and passes them to tracking  
 ///
+/// All tracks added to the VMC stack since the last step are converted
+/// in one pass; the particle definitions are cached per PDG encoding.
+/// The created G4 objects (G4DynamicParticle, G4Track, TG4TrackInformation)
+/// are allocated via their G4Allocator pools.
+///
 /// \author I. Hrivnacova; IPN Orsay
 
 class TG4StackPopper: public G4VProcess
@@ -76,11 +87,18 @@ class TG4StackPopper: public G4VProcess
 
     G4bool HasPoppedTracks() const;
 
+    void   ResetNofPoppedTracks();
+    G4int  GetNofPoppedTracks() const;
+
   private:
     /// Not implemented
     TG4StackPopper(const TG4StackPopper& right);
     /// Not implemented
     TG4StackPopper& operator = (const TG4StackPopper& right);
+
+    // methods
+    G4ParticleDefinition* GetParticleDefinition(const TParticle* particle);
+    G4Track* CreateTrack(const TParticle* particle, G4int trackId);
     
     /// this instance
     static G4ThreadLocal TG4StackPopper*  fgInstance;
@@ -88,6 +106,12 @@ class TG4StackPopper: public G4VProcess
     /// Cached pointer to thread-local VMC stack
     TVirtualMCStack*  fMCStack;
 
+    /// Cached pointer to thread-local particles manager
+    TG4ParticlesManager*  fParticlesManager;
+
+    /// The cache of particle definitions per PDG encoding
+    std::map<G4int, G4ParticleDefinition*>  fParticleDefinitions;
+
     /// the counter for popped tracks
     G4int  fNofDoneTracks;
 
@@ -99,6 +123,9 @@ class TG4StackPopper: public G4VProcess
 
     /// The track status to be restored after performing exclusive step
     G4TrackStatus fTrackStatus;
+
+    /// the counter of tracks injected in tracking in the current event
+    G4int  fNofPoppedTracks;
 };
 
 // inline methods
@@ -119,4 +146,14 @@ inline void TG4StackPopper::SetMCStack(TVirtualMCStack*  mcStack) {
   fMCStack = mcStack;
 }
 
+inline void TG4StackPopper::ResetNofPoppedTracks() {
+  /// Reset the counter of tracks injected in tracking in the current event
+  fNofPoppedTracks = 0;
+}
+
+inline G4int TG4StackPopper::GetNofPoppedTracks() const {
+  /// Return the number of tracks injected in tracking in the current event
+  return fNofPoppedTracks;
+}
+
 #endif //TG4_STACK_POPPER_H
@@ -24,6 +24,14 @@ class G4ParticleDefinition;
 /// \ingroup physics
 /// \brief Defines additional track information.
 ///
+/// The objects are allocated via a thread-local G4Allocator;
+/// its page size can be increased via SetAllocatorPageFactor()
+/// (in PreInit state, the factor is set per thread)
+/// in order to reduce the number of allocated pages in events with
+/// large numbers of secondaries.
+/// The number of live objects and its maximum are counted per thread
+/// for the memory accounting (see TG4MemoryStatistics).
+///
 /// \author I. Hrivnacova; IPN Orsay
 
 class TG4TrackInformation : public G4VUserTrackInformation
@@ -41,6 +49,14 @@ class TG4TrackInformation : public G4VUserTrackInformation
                  /// Override \em delete operator for G4Allocator
     inline void operator delete(void *trackInformation);
       
+    // static methods
+    static void SetAllocatorPageFactor(G4int factor);
+    static void PrintAllocatorStatistics();
+    static size_t GetAllocatedSize();
+    static G4int  GetNofInstances();
+    static G4int  GetMaxNofInstances();
+    static void   ResetMaxNofInstances();
+
     // methods
     virtual void Print() const;  
 
@@ -51,6 +67,8 @@ class TG4TrackInformation : public G4VUserTrackInformation
     void SetPDGEncoding(G4int pdgEncoding);
     void SetIsUserTrack(G4bool isUserTrack);
     void SetStop(G4bool stop);
+    void SetIsDropped(G4bool isDropped);
+    void SetIsRoulettePlayed(G4bool isRoulettePlayed);
 
     // get methods
     G4int  GetTrackParticleID() const;
@@ -59,8 +77,15 @@ class TG4TrackInformation : public G4VUserTrackInformation
     G4int  GetPDGEncoding() const;
     G4bool IsUserTrack() const;
     G4bool IsStop() const;
+    G4bool IsDropped() const;
+    G4bool IsRoulettePlayed() const;
 
   private:
+    // static data members
+    static G4ThreadLocal G4int  fgAllocatorPageFactor; ///< the allocator page size factor
+    static G4ThreadLocal G4int  fgNofInstances;    ///< number of live objects
+    static G4ThreadLocal G4int  fgMaxNofInstances; ///< max number of live objects
+
     // data members
     
     G4int    fTrackParticleID; ///< the index of track particle in VMC stack
@@ -69,6 +94,8 @@ class TG4TrackInformation : public G4VUserTrackInformation
     G4double fPDGEncoding;     ///< the particle PDG encoding
     G4bool   fIsUserTrack;     ///< true if defined by user and not primary track
     G4bool   fStop;            ///< true if track should be stopped
+    G4bool   fIsDropped;       ///< true if track was not saved in VMC stack
+    G4bool   fIsRoulettePlayed;///< true if Russian roulette was played for track
 };
 
 // inline methods
@@ -47,6 +47,8 @@ namespace {
 #endif
 
 TG4ParticlesManager* TG4ParticlesManager::fgInstance = 0;
+G4ThreadLocal TG4ParticlesManager::PDGEncodingMap*
+  TG4ParticlesManager::fgPDGEncodings = 0;
 
 //_____________________________________________________________________________
 TG4ParticlesManager::TG4ParticlesManager()
@@ -96,6 +98,12 @@ void TG4ParticlesManager::AddParticleToPdgDatabase(const G4String& name,
 {
 /// Add the particle definition in TDatabasePDG 
 
+  // Check and add the particle under lock, so that a particle 
+  // created at run time is registered exactly once
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&addParticleMutex);
+#endif
+
   // Return if particle was already added
   G4int pdgEncoding = particleDefinition->GetPDGEncoding();
   TParticlePDG* particlePDG 
@@ -120,20 +128,59 @@ void TG4ParticlesManager::AddParticleToPdgDatabase(const G4String& name,
   }               
 
   // Add particle to TDatabasePDG
-#ifdef G4MULTITHREADED
-  G4AutoLock lm(&addParticleMutex);
-#endif
   TDatabasePDG::Instance()
     ->AddParticle(name, g4Name, 
                   particleDefinition->GetPDGMass()/TG4G3Units::Energy(), 
                   particleDefinition->GetPDGStable(), 
                   particleDefinition->GetPDGWidth()/TG4G3Units::Energy(), 
                   pdgQ*3, rootType, pdgEncoding);
-#ifdef G4MULTITHREADED
-  lm.unlock();
-#endif
 }
 
+//_____________________________________________________________________________
+G4int TG4ParticlesManager::ResolvePDGEncoding(G4ParticleDefinition* particle)
+{
+/// Resolve the PDG code of particle (not cached);
+/// if standard PDG code is not defined the TDatabasePDG
+/// is used.
+
+  // Get PDG encoding from G4 particle definition
+  G4int pdgEncoding = particle->GetPDGEncoding();
+  if ( pdgEncoding ) {
+    // Add particle to TDatabasePDG
+    if ( ! TDatabasePDG::Instance()->GetParticle(pdgEncoding) )
+       AddParticleToPdgDatabase(particle->GetParticleName(), particle); 
+    return pdgEncoding;
+  }     
+  
+  // Get PDG encoding from TDatabasePDG if not defined in Geant4
+  
+  // get particle name from the name map
+  G4String g4name = particle->GetParticleName();
+  G4String tname = fParticleNameMap.GetSecond(g4name);
+  if ( tname == "ChargedRootino" ) tname = "Rootino"; 
+          // special treatment for Rootino
+          // user can reset the particle title to ChargedRootino to interpret
+          // Rootino as chargedgeantino
+
+  if ( tname == "Undefined") {
+    particle->DumpTable();
+    TG4Globals::Exception(
+      "TG4ParticlesManager", "GetPDGEncoding",
+      "Particle " + TString(g4name) + " was not found in the name map.");
+  }  
+  
+  // get particle from TDatabasePDG
+  TDatabasePDG* pdgDB = TDatabasePDG::Instance();
+  TParticlePDG* tparticle = pdgDB->GetParticle(tname);
+  if ( !tparticle ) {
+    TG4Globals::Exception(
+      "TG4ParticlesManager", "GetPDGEncoding",
+      "Particle " +  TString(tname) + " was not found in TDatabasePDG.");
+  }  
+  
+  // get PDG encoding
+  return tparticle->PdgCode();
+}  
 
 //
 // public methods
@@ -463,44 +510,22 @@ G4int TG4ParticlesManager::GetPDGEncoding(G4ParticleDefinition* particle)
 /// Return the PDG code of particle;
 /// if standard PDG code is not defined the TDatabasePDG
 /// is used.
+/// The code is resolved only once per particle definition (and thread)
+/// and then it is taken from the cache indexed by the particle 
+/// definition (the definition ID cannot be used as it is shared
+/// by all general ions).
 
-  // Get PDG encoding from G4 particle definition
-  G4int pdgEncoding = particle->GetPDGEncoding();
-  if ( pdgEncoding ) {
-    // Add particle to TDatabasePDG
-    if ( ! TDatabasePDG::Instance()->GetParticle(pdgEncoding) )
-       AddParticleToPdgDatabase(particle->GetParticleName(), particle); 
-    return pdgEncoding;
-  }     
-  
-  // Get PDG encoding from TDatabasePDG if not defined in Geant4
-  
-  // get particle name from the name map
-  G4String g4name = particle->GetParticleName();
-  G4String tname = fParticleNameMap.GetSecond(g4name);
-  if ( tname == "ChargedRootino" ) tname = "Rootino"; 
-          // special treatment for Rootino
-          // user can reset the particle title to ChargedRootino to interpret
-          // Rootino as chargedgeantino
+  if ( ! fgPDGEncodings ) {
+    fgPDGEncodings = new PDGEncodingMap();
+  }
 
-  if ( tname == "Undefined") {
-    particle->DumpTable();
-    TG4Globals::Exception(
-      "TG4ParticlesManager", "GetPDGEncoding",
-      "Particle " + TString(g4name) + " was not found in the name map.");
-  }  
-  
-  // get particle from TDatabasePDG
-  TDatabasePDG* pdgDB = TDatabasePDG::Instance();
-  TParticlePDG* tparticle = pdgDB->GetParticle(tname);
-  if ( !tparticle ) {
-    TG4Globals::Exception(
-      "TG4ParticlesManager", "GetPDGEncoding",
-      "Particle " +  TString(tname) + " was not found in TDatabasePDG.");
-  }  
-  
-  // get PDG encoding
-  return tparticle->PdgCode();
+  PDGEncodingMap::const_iterator it = fgPDGEncodings->find(particle);
+  if ( it != fgPDGEncodings->end() ) return it->second;
+
+  G4int pdgEncoding = ResolvePDGEncoding(particle);
+  (*fgPDGEncodings)[particle] = pdgEncoding;
+
+  return pdgEncoding;
 }  
      
 //_____________________________________________________________________________
@@ -720,6 +720,15 @@ void TG4PhysicsManager::RetrieveOpBoundaryProcess()
   }  
 }
 
+//_____________________________________________________________________________
+void TG4PhysicsManager::CacheProcesses()
+{
+/// Resolve the TMCProcess codes of all built G4 processes
+/// in the thread-local process cache
+
+  fgProcessMCMap->CacheProcesses();
+}
+
 //_____________________________________________________________________________
 TMCProcess TG4PhysicsManager::GetMCProcess(const G4VProcess* process)
 {
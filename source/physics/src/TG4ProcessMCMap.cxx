@@ -17,10 +17,14 @@
 #include "TG4Globals.h"
 
 #include <G4VProcess.hh>
+#include <G4ProcessManager.hh>
+#include <G4ProcessVector.hh>
+#include <G4ParticleTable.hh>
 #include <iomanip>
 #include "globals.hh"
 
 TG4ProcessMCMap* TG4ProcessMCMap::fgInstance = 0;
+G4ThreadLocal TG4ProcessMCMap::ProcessDataMap* TG4ProcessMCMap::fgProcessDataMap = 0;
 
 //_____________________________________________________________________________
 TG4ProcessMCMap::TG4ProcessMCMap() 
@@ -60,6 +64,29 @@ G4bool TG4ProcessMCMap::IsDefined(const G4String& processName)
     return true;
 }
 
+//_____________________________________________________________________________
+const TG4ProcessMCMap::ProcessData&
+TG4ProcessMCMap::CacheProcess(const G4VProcess* process) const
+{
+/// Resolve the TMCProcess code and the flags of the given process
+/// from its name and add them in the thread-local cache.
+
+  if ( ! fgProcessDataMap ) {
+    fgProcessDataMap = new ProcessDataMap();
+  }
+
+  const G4String& processName = process->GetProcessName();
+
+  G4int flags = 0;
+  if ( processName == "Transportation" ) flags |= kIsTransportation;
+  if ( processName == "muPairProd" )     flags |= kIsMuPairProd;
+
+  ProcessData& data = (*fgProcessDataMap)[process];
+  data = ProcessData(GetMCProcess(processName), flags);
+
+  return data;
+}
+
 //
 // public methods
 //
@@ -113,16 +140,51 @@ void TG4ProcessMCMap::Clear()
 /// Clear the map.
 
   fMap.clear();
+
+  // clear the thread-local process cache
+  if ( fgProcessDataMap ) fgProcessDataMap->clear();
 }  
 
+//_____________________________________________________________________________
+void TG4ProcessMCMap::CacheProcesses()
+{
+/// Fill the thread-local process cache with all processes
+/// defined for the particles in the particle table.
+/// This function should be called by each thread when physics is built.
+
+  if ( ! fgProcessDataMap ) {
+    fgProcessDataMap = new ProcessDataMap();
+  }
+  fgProcessDataMap->clear();
+
+  G4ParticleTable::G4PTblDicIterator* particleIterator
+    = G4ParticleTable::GetParticleTable()->GetIterator();
+  particleIterator->reset();
+  while ( (*particleIterator)() ) {
+    G4ProcessManager* processManager
+      = particleIterator->value()->GetProcessManager();
+
+    // skip particles without process manager
+    if ( ! processManager ) continue;
+
+    G4ProcessVector* processVector = processManager->GetProcessList();
+    for ( G4int i=0; i<processVector->length(); i++ ) {
+      const G4VProcess* process = (*processVector)[i];
+      if ( fgProcessDataMap->find(process) == fgProcessDataMap->end() )
+        CacheProcess(process);
+    }
+  }
+}
+
 //_____________________________________________________________________________
 TMCProcess TG4ProcessMCMap::GetMCProcess(const G4VProcess* process) const
 {
-/// Return TMCProcess code for the process with a given name.
+/// Return TMCProcess code for the given process.
+/// The code is taken from the thread-local process cache.
 
   if (!process) return kPNoProcess;
   
-  return GetMCProcess(process->GetProcessName());
+  return GetProcessData(process).first;
 }
 
 //_____________________________________________________________________________
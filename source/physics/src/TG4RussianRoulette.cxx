@@ -0,0 +1,295 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RussianRoulette.cxx
+/// \brief Implementation of the TG4RussianRoulette class 
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TG4RussianRoulette.h"
+#include "TG4GeometryServices.h"
+#include "TG4MediumMap.h"
+#include "TG4Medium.h"
+#include "TG4Limits.h"
+#include "TG4TrackManager.h"
+#include "TG4TrackInformation.h"
+#include "TG4Globals.h"
+
+#include <G4Track.hh>
+#include <G4LogicalVolume.hh>
+#include <G4AutoLock.hh>
+#include <Randomize.hh>
+
+#include <iomanip>
+
+// mutex in a file scope
+
+namespace {
+#ifdef G4MULTITHREADED
+  //Mutex to lock the merged statistics
+  G4Mutex mergeMutex = G4MUTEX_INITIALIZER;
+#endif
+}
+
+G4ThreadLocal TG4RussianRoulette* TG4RussianRoulette::fgInstance = 0;
+std::map<G4String, TG4RussianRoulette::Statistics> 
+  TG4RussianRoulette::fgStatistics;
+
+//_____________________________________________________________________________
+TG4RussianRoulette::TG4RussianRoulette(const G4String& processName)
+  : G4VProcess(processName, fUserDefined),
+    fTrackManager(TG4TrackManager::Instance()),
+    fEnergyFactor(1.),
+    fSurvivalProbability(1.),
+    fMediumNames(),
+    fMediumIds(),
+    fIsResolved(false),
+    fParticleWSPs(),
+    fLVMediumIds(),
+    fCurrentMediumId(0),
+    fStatistics()
+{
+/// Standard constructor
+
+  if (fgInstance) { 
+    TG4Globals::Exception(
+      "TG4RussianRoulette", "TG4RussianRoulette", 
+      "Cannot create two instances of singleton.");
+  }
+
+  fgInstance = this;
+}
+
+//_____________________________________________________________________________
+TG4RussianRoulette::~TG4RussianRoulette() 
+{
+/// Destructor
+
+  fgInstance = 0;
+}
+
+//
+// static methods
+//
+
+//_____________________________________________________________________________
+void TG4RussianRoulette::PrintStatistics()
+{
+/// Print the merged statistics per medium
+
+  TG4Globals::PrintStars(true);
+  G4cout << "Russian roulette statistics per medium: " << G4endl
+         << std::setw(20) << "medium" 
+         << std::setw(12) << "played"
+         << std::setw(12) << "killed"
+         << std::setw(14) << "weight in"
+         << std::setw(14) << "weight out"
+         << std::setw(10) << "out/in" << G4endl;
+
+  std::map<G4String, Statistics>::const_iterator it;
+  for ( it = fgStatistics.begin(); it != fgStatistics.end(); ++it ) {
+    const Statistics& stat = it->second;
+    G4double ratio 
+      = ( stat.fWeightIn > 0. ) ? stat.fWeightOut/stat.fWeightIn : 0.;
+    G4cout << std::setw(20) << it->first 
+           << std::setw(12) << stat.fNofPlayed
+           << std::setw(12) << stat.fNofKilled
+           << std::setw(14) << stat.fWeightIn
+           << std::setw(14) << stat.fWeightOut
+           << std::setw(10) << ratio << G4endl;
+  }
+  TG4Globals::PrintStars(false);
+}
+
+//_____________________________________________________________________________
+void TG4RussianRoulette::ClearStatistics()
+{
+/// Clear the merged statistics
+
+  fgStatistics.clear();
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4double TG4RussianRoulette::GetThreshold(const TG4Limits& limits, 
+                                          const G4Track& track) const
+{
+/// Return the energy threshold for the given track in the given limits
+
+  size_t particleID = track.GetDefinition()->GetParticleDefinitionID();
+  if ( particleID >= fParticleWSPs.size() ) return 0.;
+
+  G4double cut = 0.;
+  switch ( fParticleWSPs[particleID] ) {
+    case kGamma:         cut = limits.GetMinEkineForGamma(track);         break;
+    case kElectron:      cut = limits.GetMinEkineForElectron(track);      break;
+    case kEplus:         cut = limits.GetMinEkineForEplus(track);         break;
+    case kNeutralHadron: cut = limits.GetMinEkineForNeutralHadron(track); break;
+    case kChargedHadron: cut = limits.GetMinEkineForChargedHadron(track); break;
+    case kMuon:          cut = limits.GetMinEkineForMuon(track);          break;
+    case kAny:           cut = limits.GetMinEkineForOther(track);         break;
+    default:             break;
+  }  
+  
+  return fEnergyFactor * cut;
+}
+
+//_____________________________________________________________________________
+G4int TG4RussianRoulette::GetMediumId(G4LogicalVolume* lv)
+{
+/// Return the medium ID of the given logical volume 
+/// (the values are cached per logical volume)
+
+  size_t lvID = lv->GetInstanceID();
+  if ( lvID >= fLVMediumIds.size() ) fLVMediumIds.resize(lvID+1, -1);
+
+  if ( fLVMediumIds[lvID] < 0 ) {
+    fLVMediumIds[lvID] = TG4GeometryServices::Instance()->GetMediumId(lv);
+  }
+  
+  return fLVMediumIds[lvID];
+}
+
+//_____________________________________________________________________________
+void TG4RussianRoulette::ResolveMedia()
+{
+/// Convert the media names in their IDs;
+/// this can be done only after the geometry is built.
+
+  fIsResolved = true;
+  fMediumIds.clear();
+
+  TG4MediumMap* mediumMap = TG4GeometryServices::Instance()->GetMediumMap();
+  std::set<G4String>::const_iterator it;
+  for ( it = fMediumNames.begin(); it != fMediumNames.end(); ++it ) {
+    TG4Medium* medium = mediumMap->GetMedium(*it, false);
+    if ( ! medium ) {
+      TG4Globals::Warning(
+        "TG4RussianRoulette", "ResolveMedia",
+        "Medium " + TString(*it) + " not found.");
+      continue;
+    }
+    fMediumIds.insert(medium->GetID());
+  }
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4RussianRoulette::SetParticleWSP(const G4ParticleDefinition* particle,
+                                        TG4G3ParticleWSP particleWSP)
+{
+/// Set the particle type which defines the medium cut used for the particle
+
+  size_t particleID = particle->GetParticleDefinitionID();
+  if ( particleID >= fParticleWSPs.size() ) 
+    fParticleWSPs.resize(particleID+1, kNofParticlesWSP);
+
+  fParticleWSPs[particleID] = particleWSP;
+}  
+
+//_____________________________________________________________________________
+void TG4RussianRoulette::Merge()
+{
+/// Merge the statistics of this thread in the merged statistics 
+/// (by medium names) and reset them.
+
+  TG4MediumMap* mediumMap = TG4GeometryServices::Instance()->GetMediumMap();
+
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&mergeMutex);
+#endif
+
+  std::map<G4int, Statistics>::const_iterator it;
+  for ( it = fStatistics.begin(); it != fStatistics.end(); ++it ) {
+    TG4Medium* medium = mediumMap->GetMedium(it->first, false);
+    G4String name = medium ? medium->GetName() : G4String("none");
+
+    Statistics& stat = fgStatistics[name];
+    stat.fNofPlayed += it->second.fNofPlayed;
+    stat.fNofKilled += it->second.fNofKilled;
+    stat.fWeightIn  += it->second.fWeightIn;
+    stat.fWeightOut += it->second.fWeightOut;
+  }  
+
+#ifdef G4MULTITHREADED
+  lm.unlock();
+#endif
+
+  fStatistics.clear();
+}
+
+//_____________________________________________________________________________
+G4double TG4RussianRoulette::PostStepGetPhysicalInteractionLength(
+                             const G4Track& track,
+                             G4double /*notUsed*/,
+                             G4ForceCondition* condition)
+{
+/// Return zero step if the roulette should be played with this track,
+/// DBL_MAX otherwise.
+
+  *condition = NotForced;
+
+  G4LogicalVolume* lv = track.GetVolume()->GetLogicalVolume();
+  TG4Limits* limits = (TG4Limits*) lv->GetUserLimits();
+  if ( ! limits ) return DBL_MAX;
+
+  if ( track.GetKineticEnergy() >= GetThreshold(*limits, track) ) 
+    return DBL_MAX;
+
+  TG4TrackInformation* trackInformation
+    = fTrackManager->GetTrackInformation(&track);
+  if ( ! trackInformation || trackInformation->IsRoulettePlayed() ) 
+    return DBL_MAX;
+
+  fCurrentMediumId = GetMediumId(lv);
+  if ( fMediumNames.size() ) {
+    if ( ! fIsResolved ) ResolveMedia();
+    if ( fMediumIds.find(fCurrentMediumId) == fMediumIds.end() ) 
+      return DBL_MAX;
+  }  
+
+  return 0.;
+}
+
+//_____________________________________________________________________________
+G4VParticleChange* TG4RussianRoulette::PostStepDoIt(const G4Track& track, 
+                                                    const G4Step& /*step*/)
+{
+/// Play the roulette: kill the track or increase its weight.
+/// No energy is deposited when the track is killed, as the killed tracks
+/// are represented by the survivors with increased weight.
+
+  aParticleChange.Initialize(track);
+
+  fTrackManager->GetTrackInformation(&track)->SetIsRoulettePlayed(true);
+
+  Statistics& stat = fStatistics[fCurrentMediumId];
+  G4double weight = track.GetWeight();
+  ++stat.fNofPlayed;
+  stat.fWeightIn += weight;
+
+  if ( G4UniformRand() < fSurvivalProbability ) {
+    weight /= fSurvivalProbability;
+    stat.fWeightOut += weight;
+    aParticleChange.ProposeParentWeight(weight);
+  }
+  else {
+    ++stat.fNofKilled;
+    aParticleChange.ProposeEnergy(0.);
+    aParticleChange.ProposeTrackStatus(fStopAndKill);
+  }
+
+  return &aParticleChange;
+}
@@ -18,6 +18,7 @@
 #include "TG4TrackInformation.h"
 
 #include <G4Track.hh>
+#include <G4DynamicParticle.hh>
 #include <G4IonTable.hh>
 
 #include <TVirtualMC.h>
@@ -31,8 +32,12 @@ G4ThreadLocal TG4StackPopper* TG4StackPopper::fgInstance = 0;
 TG4StackPopper::TG4StackPopper(const G4String& processName)
   : G4VProcess(processName, fUserDefined),
     fMCStack(0),
+    fParticlesManager(0),
+    fParticleDefinitions(),
     fNofDoneTracks(0),
-    fDoExclusiveStep(false)
+    fDoExclusiveStep(false),
+    fTrackStatus(fAlive),
+    fNofPoppedTracks(0)
 {
 /// Standard constructor
 
@@ -46,6 +51,7 @@ TG4StackPopper::TG4StackPopper(const G4String& processName)
 
   // Cache thread-local pointers
   fMCStack = gMC->GetStack();
+  fParticlesManager = TG4ParticlesManager::Instance();
 }
 
 //_____________________________________________________________________________
@@ -56,6 +62,78 @@ TG4StackPopper::~TG4StackPopper()
   fgInstance = 0;
 }
 
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4ParticleDefinition* TG4StackPopper::GetParticleDefinition(
+                                         const TParticle* particle)
+{
+/// Return G4 particle definition for the given TParticle;
+/// the definitions found via PDG encoding are cached
+
+  G4int pdgEncoding = particle->GetPdgCode();
+  if ( pdgEncoding == 0 ) 
+    return fParticlesManager->GetParticleDefinition(particle);
+
+  std::map<G4int, G4ParticleDefinition*>::const_iterator it 
+    = fParticleDefinitions.find(pdgEncoding);
+  if ( it != fParticleDefinitions.end() ) return it->second;
+
+  G4ParticleDefinition* particleDefinition 
+    = fParticlesManager->GetParticleDefinition(particle);
+  if ( particleDefinition ) 
+    fParticleDefinitions[pdgEncoding] = particleDefinition;
+
+  return particleDefinition;
+}
+
+//_____________________________________________________________________________
+G4Track* TG4StackPopper::CreateTrack(const TParticle* particle, G4int trackId)
+{
+/// Create G4Track with the track information for the given TParticle
+
+  // Create dynamic particle
+  G4ParticleDefinition* particleDefinition = GetParticleDefinition(particle);
+  if ( ! particleDefinition ) {
+    TG4Globals::Exception(
+      "TG4StackPopper", "CreateTrack",
+      "Conversion from Root particle -> G4 particle failed.");
+    return 0;  
+  }    
+
+  // (the conversions are the same as in 
+  // TG4ParticlesManager::CreateDynamicParticle(), except for the particle
+  // definition, which is taken from the cache)
+  G4DynamicParticle* dynamicParticle 
+    = new G4DynamicParticle(particleDefinition, 
+                            fParticlesManager->GetParticleMomentum(particle));
+
+  G4ThreeVector polarization 
+    = fParticlesManager->GetParticlePolarization(particle);
+  dynamicParticle
+    ->SetPolarization(polarization.x(), polarization.y(), polarization.z());
+
+  // Define track
+  G4double time = particle->T()*TG4G3Units::Time(); 
+
+  G4Track* track 
+    = new G4Track(dynamicParticle, time, 
+                  fParticlesManager->GetParticlePosition(particle));
+
+  // set track information here to avoid saving track in the stack
+  // for the second time  
+  TG4TrackInformation* trackInformation = new TG4TrackInformation(trackId);
+      // the track information is deleted together with its
+      // G4Track object  
+  trackInformation->SetIsUserTrack(true);
+  trackInformation->SetPDGEncoding(particle->GetPdgCode());
+  track->SetUserInformation(trackInformation);
+
+  return track;
+}  
+
 //
 // public methods
 //
@@ -97,9 +175,9 @@ G4VParticleChange* TG4StackPopper::PostStepDoIt(const G4Track& track,
   aParticleChange.SetNumberOfSecondaries(
                       aParticleChange.GetNumberOfSecondaries()+nofTracksToPop);
  
+  // Pop all tracks added in the stack since the last step in one pass
   for (G4int i=0; i<nofTracksToPop; ++i) {
 
-    // Pop particle from the stack
     G4int itrack;
     TParticle* particle = fMCStack->PopNextTrack(itrack);
     ++fNofDoneTracks;
@@ -109,42 +187,17 @@ G4VParticleChange* TG4StackPopper::PostStepDoIt(const G4Track& track,
         "TG4StackPopper", "PostStepDoIt", "No particle popped from stack!");
       return &aParticleChange;
     }  
-      
 
     //G4cout << "TG4StackPopper::PostStepDoIt: Popped particle = "
     //       << particle->GetName()
     //       << " trackID = "<< itrack << G4endl;
 
-    // Create dynamic particle
-    G4DynamicParticle* dynamicParticle 
-      = TG4ParticlesManager::Instance()->CreateDynamicParticle(particle);
-    if ( ! dynamicParticle ) {
-      TG4Globals::Exception(
-        "TG4StackPopper", "PostStepDoIt",
-        "Conversion from Root particle -> G4 particle failed.");
-    }    
- 
-    // Define track
-
-    G4ThreeVector position 
-      = TG4ParticlesManager::Instance()->GetParticlePosition(particle);
-    G4double time = particle->T()*TG4G3Units::Time(); 
-
-    G4Track* secondaryTrack  
-      = new G4Track(dynamicParticle, time, position);
-
-    // set track information here to avoid saving track in the stack
-    // for the second time  
-    TG4TrackInformation* trackInformation 
-      = new TG4TrackInformation(itrack);
-        // the track information is deleted together with its
-        // G4Track object  
-    trackInformation->SetIsUserTrack(true);
-    trackInformation->SetPDGEncoding(particle->GetPdgCode());
-    secondaryTrack->SetUserInformation(trackInformation);
-      
+    G4Track* secondaryTrack = CreateTrack(particle, itrack);
+    if ( ! secondaryTrack ) continue;
+
     // Add track as a secondary
     aParticleChange.AddSecondary(secondaryTrack);
+    ++fNofPoppedTracks;
   }
 
   // Set back current track number in the track
@@ -13,10 +13,16 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include "TG4TrackInformation.h"
+#include "TG4Globals.h"
 
 /// Geant4 allocator for TG4TrackInformation objects
 G4ThreadLocal G4Allocator<TG4TrackInformation>* gTrackInfoAllocator = 0;
 
+// static data members
+G4ThreadLocal G4int TG4TrackInformation::fgAllocatorPageFactor = 1;
+G4ThreadLocal G4int TG4TrackInformation::fgNofInstances = 0;
+G4ThreadLocal G4int TG4TrackInformation::fgMaxNofInstances = 0;
+
 //_____________________________________________________________________________
 TG4TrackInformation::TG4TrackInformation()
   : G4VUserTrackInformation(),
@@ -25,7 +31,9 @@ TG4TrackInformation::TG4TrackInformation()
     fPDGLifetime(-1.0),
     fPDGEncoding(0),
     fIsUserTrack(false),
-    fStop(false)
+    fStop(false),
+    fIsDropped(false),
+    fIsRoulettePlayed(false)
 {
 /// Default constructor
 }
@@ -38,7 +46,9 @@ TG4TrackInformation::TG4TrackInformation(G4int trackParticleID)
     fPDGLifetime(-1.0), 
     fPDGEncoding(0),
     fIsUserTrack(false),
-    fStop(false)
+    fStop(false),
+    fIsDropped(false),
+    fIsRoulettePlayed(false)
 {
 /// Standard constructor
 }    
@@ -59,6 +69,65 @@ TG4TrackInformation::~TG4TrackInformation()
 /// Destructor
 }    
 
+//
+// static methods
+//
+
+//_____________________________________________________________________________
+void TG4TrackInformation::SetAllocatorPageFactor(G4int factor)
+{
+/// Set the factor by which the default page size of the track information
+/// allocator is increased in this thread. \n
+/// It has to be set before the first track information object is created
+/// in the thread; it is applied via the /mcTracking/trackInfoPageFactor
+/// command in PreInit state, which is then executed also on each worker.
+
+  if ( factor < 1 ) {
+    TG4Globals::Warning(
+      "TG4TrackInformation", "SetAllocatorPageFactor",
+      "The page factor must be >= 1, the setting is ignored.");
+    return;
+  }
+
+  if ( gTrackInfoAllocator ) {
+    TG4Globals::Warning(
+      "TG4TrackInformation", "SetAllocatorPageFactor",
+      "The allocator was already created in this thread, the setting is ignored.");
+    return;
+  }
+
+  fgAllocatorPageFactor = factor;
+}
+
+//_____________________________________________________________________________
+void TG4TrackInformation::PrintAllocatorStatistics()
+{
+/// Print the number of pages and the memory allocated by the thread-local
+/// track information allocator
+
+  G4cout << "TG4TrackInformation allocator: ";
+  if ( ! gTrackInfoAllocator ) {
+    G4cout << "not yet created" << G4endl;
+    return;
+  }
+
+  G4cout << gTrackInfoAllocator->GetNoPages() << " pages of "
+         << gTrackInfoAllocator->GetPageSize() << " bytes, "
+         << gTrackInfoAllocator->GetAllocatedSize() << " bytes allocated"
+         << G4endl;
+}
+
+//_____________________________________________________________________________
+size_t TG4TrackInformation::GetAllocatedSize()
+{
+/// Return the memory allocated by the thread-local track information 
+/// allocator (in bytes)
+
+  if ( ! gTrackInfoAllocator ) return 0;
+
+  return gTrackInfoAllocator->GetAllocatedSize();
+}
+
 //
 // public methods
 //
@@ -73,6 +142,8 @@ void TG4TrackInformation::Print() const
 
   if ( fIsUserTrack ) G4cout << "  userTrack";
   if ( fStop )        G4cout << "  toStop";
+  if ( fIsDropped )   G4cout << "  dropped";
+  if ( fIsRoulettePlayed ) G4cout << "  roulettePlayed";
 
   G4cout << G4endl;
 }
@@ -0,0 +1,79 @@
+#ifndef TG4_RUSSIAN_ROULETTE_MESSENGER_H
+#define TG4_RUSSIAN_ROULETTE_MESSENGER_H 
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RussianRouletteMessenger.h
+/// \brief Definition of the TG4RussianRouletteMessenger class 
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class TG4RussianRoulettePhysics;
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+
+/// \ingroup physics_list
+/// \brief Messenger class that defines commands for the Russian roulette
+///        special process
+///
+/// Implements commands:
+/// - /mcPhysics/russianRoulette/setSelection [particleName1 particleName2 ...]
+/// - /mcPhysics/russianRoulette/setEnergyFactor factor
+/// - /mcPhysics/russianRoulette/setSurvivalProbability probability
+/// - /mcPhysics/russianRoulette/addMedium mediumName
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+class TG4RussianRouletteMessenger: public G4UImessenger
+{
+  public:
+    TG4RussianRouletteMessenger(TG4RussianRoulettePhysics* roulettePhysics); 
+    virtual ~TG4RussianRouletteMessenger();
+   
+    // methods 
+    virtual void SetNewValue(G4UIcommand* command, G4String string);
+    
+  private:
+    /// Not implemented
+    TG4RussianRouletteMessenger();  
+    /// Not implemented
+    TG4RussianRouletteMessenger(const TG4RussianRouletteMessenger& right);
+    /// Not implemented
+    TG4RussianRouletteMessenger& operator=(
+                                const TG4RussianRouletteMessenger& right);
+
+    //
+    // data members
+    
+    /// associated class
+    TG4RussianRoulettePhysics*  fRoulettePhysics;
+    
+    /// command directory
+    G4UIdirectory*  fDirectory;
+
+    /// setSelection command
+    G4UIcmdWithAString*  fSetSelectionCmd;
+
+    /// setEnergyFactor command
+    G4UIcmdWithADouble*  fSetEnergyFactorCmd;
+
+    /// setSurvivalProbability command
+    G4UIcmdWithADouble*  fSetSurvivalProbabilityCmd;
+
+    /// addMedium command
+    G4UIcmdWithAString*  fAddMediumCmd;
+};    
+
+#endif //TG4_RUSSIAN_ROULETTE_MESSENGER_H
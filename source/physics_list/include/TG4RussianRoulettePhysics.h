@@ -0,0 +1,93 @@
+#ifndef TG4_RUSSIAN_ROULETTE_PHYSICS_H
+#define TG4_RUSSIAN_ROULETTE_PHYSICS_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RussianRoulettePhysics.h
+/// \brief Definition of the TG4RussianRoulettePhysics class 
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TG4VPhysicsConstructor.h"
+#include "TG4RussianRouletteMessenger.h"
+
+#include <globals.hh>
+
+#include <set>
+
+class TG4RussianRoulette;
+
+/// \ingroup physics_list
+/// \brief The builder for Russian roulette process
+///
+/// The process is added to the selected particles (gamma and neutron
+/// by default).
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+class TG4RussianRoulettePhysics : public TG4VPhysicsConstructor
+{
+  public:
+    TG4RussianRoulettePhysics(const G4String& name = "RussianRoulette");
+    TG4RussianRoulettePhysics(G4int theVerboseLevel,
+                              const G4String& name = "RussianRoulette");
+    virtual ~TG4RussianRoulettePhysics();
+    
+    // set methods
+    void SetSelection(const G4String& selection);
+    void SetEnergyFactor(G4double energyFactor);
+    void SetSurvivalProbability(G4double survivalProbability);
+    void AddMediumName(const G4String& mediumName);
+
+  protected:
+    // methods
+          // construct particle and physics
+    virtual void ConstructParticle();
+    virtual void ConstructProcess();
+
+  private:
+    /// Not implemented
+    TG4RussianRoulettePhysics(const TG4RussianRoulettePhysics& right);
+    /// Not implemented
+    TG4RussianRoulettePhysics& operator=(const TG4RussianRoulettePhysics& right);
+    
+    // data members
+    TG4RussianRouletteMessenger  fMessenger;  ///< messenger
+    TG4RussianRoulette*  fRouletteProcess;    ///< Russian roulette process
+    G4String             fSelection;          ///< particles selection
+    G4double             fEnergyFactor;       ///< energy threshold factor
+    G4double             fSurvivalProbability;///< survival probability
+    std::set<G4String>   fMediumNames;        ///< selected media names
+};
+
+// inline functions
+
+inline void TG4RussianRoulettePhysics::SetSelection(const G4String& selection) {
+  /// Set particles selection
+  fSelection = selection;
+}  
+
+inline void TG4RussianRoulettePhysics::SetEnergyFactor(G4double energyFactor) {
+  /// Set the factor applied to the medium energy cut to get the threshold
+  fEnergyFactor = energyFactor;
+}  
+
+inline void TG4RussianRoulettePhysics::SetSurvivalProbability(
+                                         G4double survivalProbability) {
+  /// Set the survival probability
+  fSurvivalProbability = survivalProbability;
+}  
+
+inline void TG4RussianRoulettePhysics::AddMediumName(const G4String& mediumName) {
+  /// Add the medium where the roulette is played (all media if none is added)
+  fMediumNames.insert(mediumName);
+}  
+
+#endif //TG4_RUSSIAN_ROULETTE_PHYSICS_H
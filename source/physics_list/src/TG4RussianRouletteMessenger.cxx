@@ -0,0 +1,109 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RussianRouletteMessenger.cxx
+/// \brief Implementation of the TG4RussianRouletteMessenger class 
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TG4RussianRouletteMessenger.h"
+#include "TG4RussianRoulettePhysics.h"
+
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithADouble.hh>
+
+//______________________________________________________________________________
+TG4RussianRouletteMessenger::TG4RussianRouletteMessenger(
+                                 TG4RussianRoulettePhysics* roulettePhysics)
+  : G4UImessenger(),
+    fRoulettePhysics(roulettePhysics),
+    fDirectory(0),
+    fSetSelectionCmd(0),
+    fSetEnergyFactorCmd(0),
+    fSetSurvivalProbabilityCmd(0),
+    fAddMediumCmd(0)
+{ 
+/// Standard constructor
+
+  fDirectory = new G4UIdirectory("/mcPhysics/russianRoulette/");
+  fDirectory->SetGuidance("Russian roulette control commands.");
+
+  fSetSelectionCmd 
+    = new G4UIcmdWithAString("/mcPhysics/russianRoulette/setSelection", this);  
+  fSetSelectionCmd->SetGuidance("Selects particles for Russian roulette process");
+  fSetSelectionCmd->SetGuidance("(By default: gamma neutron)");
+  fSetSelectionCmd->SetParameterName("RouletteSelection", false);
+  fSetSelectionCmd->AvailableForStates(G4State_PreInit);  
+
+  fSetEnergyFactorCmd 
+    = new G4UIcmdWithADouble("/mcPhysics/russianRoulette/setEnergyFactor", this);  
+  fSetEnergyFactorCmd
+    ->SetGuidance("Set the factor which multiplied by the medium energy cut");
+  fSetEnergyFactorCmd
+    ->SetGuidance("gives the energy threshold for Russian roulette.");
+  fSetEnergyFactorCmd->SetParameterName("EnergyFactor", false);
+  fSetEnergyFactorCmd->SetRange("EnergyFactor > 0.");
+  fSetEnergyFactorCmd->AvailableForStates(G4State_PreInit);  
+
+  fSetSurvivalProbabilityCmd 
+    = new G4UIcmdWithADouble(
+        "/mcPhysics/russianRoulette/setSurvivalProbability", this);  
+  fSetSurvivalProbabilityCmd
+    ->SetGuidance("Set the survival probability in Russian roulette.");
+  fSetSurvivalProbabilityCmd->SetParameterName("SurvivalProbability", false);
+  fSetSurvivalProbabilityCmd
+    ->SetRange("SurvivalProbability > 0. && SurvivalProbability <= 1.");
+  fSetSurvivalProbabilityCmd->AvailableForStates(G4State_PreInit);  
+
+  fAddMediumCmd 
+    = new G4UIcmdWithAString("/mcPhysics/russianRoulette/addMedium", this);  
+  fAddMediumCmd->SetGuidance("Add the medium where Russian roulette is played");
+  fAddMediumCmd->SetGuidance("(By default it is played in all media.)");
+  fAddMediumCmd->SetParameterName("MediumName", false);
+  fAddMediumCmd->AvailableForStates(G4State_PreInit);  
+}
+
+//______________________________________________________________________________
+TG4RussianRouletteMessenger::~TG4RussianRouletteMessenger() 
+{
+/// Destructor
+
+  delete fDirectory;
+  delete fSetSelectionCmd;
+  delete fSetEnergyFactorCmd;
+  delete fSetSurvivalProbabilityCmd;
+  delete fAddMediumCmd;
+}
+
+//
+// public methods
+//
+
+//______________________________________________________________________________
+void TG4RussianRouletteMessenger::SetNewValue(G4UIcommand* command,
+                                              G4String newValue)
+{ 
+/// Apply command to the associated object.
+  
+  if ( command == fSetSelectionCmd ) {
+    fRoulettePhysics->SetSelection(newValue);
+  }  
+  else if ( command == fSetEnergyFactorCmd ) {
+    fRoulettePhysics->SetEnergyFactor(
+      fSetEnergyFactorCmd->GetNewDoubleValue(newValue));
+  }  
+  else if ( command == fSetSurvivalProbabilityCmd ) {
+    fRoulettePhysics->SetSurvivalProbability(
+      fSetSurvivalProbabilityCmd->GetNewDoubleValue(newValue));
+  }  
+  else if ( command == fAddMediumCmd ) {
+    fRoulettePhysics->AddMediumName(newValue);
+  }  
+}
@@ -0,0 +1,110 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2018 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RussianRoulettePhysics.cxx
+/// \brief Implementation of the TG4RussianRoulettePhysics class 
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TG4RussianRoulettePhysics.h"
+#include "TG4RussianRoulette.h"
+#include "TG4G3PhysicsManager.h"
+
+#include <G4ParticleDefinition.hh>
+#include <G4ProcessManager.hh>
+
+//_____________________________________________________________________________
+TG4RussianRoulettePhysics::TG4RussianRoulettePhysics(const G4String& name)
+  : TG4VPhysicsConstructor(name),
+    fMessenger(this),
+    fRouletteProcess(0),
+    fSelection("gamma neutron"),
+    fEnergyFactor(10.),
+    fSurvivalProbability(0.5),
+    fMediumNames()
+{
+/// Standard constructor
+}
+
+//_____________________________________________________________________________
+TG4RussianRoulettePhysics::TG4RussianRoulettePhysics(G4int theVerboseLevel,
+                                                     const G4String& name)
+  : TG4VPhysicsConstructor(name, theVerboseLevel), 
+    fMessenger(this),
+    fRouletteProcess(0),
+    fSelection("gamma neutron"),
+    fEnergyFactor(10.),
+    fSurvivalProbability(0.5),
+    fMediumNames()
+{
+/// Standard constructor
+}
+
+//_____________________________________________________________________________
+TG4RussianRoulettePhysics::~TG4RussianRoulettePhysics() 
+{
+/// Destructor
+
+  delete fRouletteProcess;
+}
+
+//
+// protected methods
+//
+
+//_____________________________________________________________________________
+void TG4RussianRoulettePhysics::ConstructParticle()
+{
+/// No particles instatiated 
+
+}
+
+//_____________________________________________________________________________
+void TG4RussianRoulettePhysics::ConstructProcess()
+{
+/// Add Russian roulette process to selected particles which
+/// have a special cut type (see TG4G3ParticleWSP)
+
+  fRouletteProcess = new TG4RussianRoulette();
+  fRouletteProcess->SetEnergyFactor(fEnergyFactor);
+  fRouletteProcess->SetSurvivalProbability(fSurvivalProbability);
+  fRouletteProcess->SetMediumNames(fMediumNames);
+
+  TG4G3PhysicsManager* g3PhysicsManager = TG4G3PhysicsManager::Instance();
+
+  auto aParticleIterator = GetParticleIterator();
+  aParticleIterator->reset();
+  while ( (*aParticleIterator)() ) {
+
+    G4ParticleDefinition* particle = aParticleIterator->value();
+    G4ProcessManager* pmanager = particle->GetProcessManager();
+
+    // skip particles which do not have process manager
+    if ( ! pmanager ) continue;
+
+    if ( fSelection.find(particle->GetParticleName()) == std::string::npos ) 
+      continue;
+
+    TG4G3ParticleWSP particleWSP 
+      = g3PhysicsManager->GetG3ParticleWSP(particle);
+    if ( particleWSP == kNofParticlesWSP ) continue;
+
+    if (VerboseLevel() > 1) {
+      G4cout << "Adding Russian roulette process to " 
+             <<  particle->GetParticleName() << G4endl;
+    }         
+
+    fRouletteProcess->SetParticleWSP(particle, particleWSP);
+    pmanager->AddDiscreteProcess(fRouletteProcess);
+  }
+  
+  if (VerboseLevel() > 0) {
+    G4cout << "### Russian roulette physics constructed." << G4endl;
+  }
+}
@@ -16,6 +16,7 @@
 #include "TG4SpecialCutsPhysics.h"
 #include "TG4StepLimiterPhysics.h"
 #include "TG4StackPopperPhysics.h"
+#include "TG4RussianRoulettePhysics.h"
 #include "TG4TransitionRadiationPhysics.h"
 #include "TG4UserParticlesPhysics.h"
 #include "TG4ExtDecayerPhysics.h"
@@ -54,6 +55,7 @@ G4String TG4SpecialPhysicsList::AvailableSelections()
   selections += "stepLimiter ";
   selections += "specialCuts ";
   selections += "stackPopper ";
+  selections += "russianRoulette ";
   selections += "gflash ";
   
   return selections;
@@ -168,6 +170,10 @@ void TG4SpecialPhysicsList::Configure(const G4String& selection)
         = new TG4StackPopperPhysics(tg4VerboseLevel); 
       RegisterPhysics(fStackPopperPhysics);
     }
+    else if ( token == "russianRoulette" ) {    
+      // G4cout << "Registering Russian roulette physics" << G4endl;
+      RegisterPhysics(new TG4RussianRoulettePhysics(tg4VerboseLevel));
+    }
     else if ( token == "gflash") {
       isGflash = true;
     }
@@ -25,6 +25,8 @@ class G4UIdirectory;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithAString;
 class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADouble;
 
 /// \ingroup run
 /// \brief Messenger class that defines commands for TG4RunManager
@@ -35,6 +37,16 @@ class G4UIcmdWithABool;
 /// - /mcControl/rootCmd [cmdString]
 /// - /mcControl/useRootRandom [true|false]
 /// - /mcControl/g3Defaults
+/// - /mcControl/setStepProfiling [true|false]
+/// - /mcControl/setStepProfilingSampling nofSteps
+/// - /mcControl/setStepProfilingNofTop nofEntries
+/// - /mcControl/setStepProfilingOutput fileName
+/// - /mcControl/clearStepProfiling
+/// - /mcControl/setG4RootSafetyReuse [true|false]
+/// - /mcControl/setG4RootSafetyReuseFraction fraction
+/// - /mcControl/setG4RootSafetyCheck [true|false]
+///
+/// The G4Root commands are available only if built with G4Root.
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -64,6 +76,21 @@ class TG4RunMessenger: public G4UImessenger
     TG4UICmdWithAComplexString* fRootCommandCmd;  ///< command: rootCmd 
     G4UIcmdWithABool*           fUseRootRandomCmd;///< command: useRootRandom   
     G4UIcmdWithoutParameter*    fG3DefaultsCmd;   ///< command: g3Defaults   
+    G4UIcmdWithABool*           fStepProfilingCmd;///< command: setStepProfiling
+    /// command: setStepProfilingSampling
+    G4UIcmdWithAnInteger*       fStepProfilingSamplingCmd;
+    /// command: setStepProfilingNofTop
+    G4UIcmdWithAnInteger*       fStepProfilingNofTopCmd;
+    /// command: setStepProfilingOutput
+    G4UIcmdWithAString*         fStepProfilingOutputCmd;
+    /// command: clearStepProfiling
+    G4UIcmdWithoutParameter*    fClearStepProfilingCmd;
+    /// command: setG4RootSafetyReuse
+    G4UIcmdWithABool*           fG4RootSafetyReuseCmd;
+    /// command: setG4RootSafetyReuseFraction
+    G4UIcmdWithADouble*         fG4RootSafetyReuseFractionCmd;
+    /// command: setG4RootSafetyCheck
+    G4UIcmdWithABool*           fG4RootSafetyCheckCmd;
 };
 
 #endif //TG4_RUN_MESSENGER_H
@@ -29,6 +29,7 @@ class TG4PhysicsManager;
 class TG4StepManager;
 class TG4VisManager;
 class TG4RunManager;
+struct TG4StepRecord;
 
 class G4VisExecutive;
 
@@ -364,6 +365,15 @@ class TGeant4: public TVirtualMC
     virtual Int_t   CurrentEvent() const; 
     virtual Bool_t  SecondariesAreOrdered() const;
 
+        // Step record (G4 specific)
+    const TG4StepRecord& GetStepRecord() const;
+    void  SetStepRecordNofLevels(Int_t nofLevels);
+    ULong64_t CurrentVolPathHash() const;
+
+        // Batched coordinates transformations (G4 specific)
+    void  Gmtod(Int_t n, const Double_t* xm, Double_t* xd, Int_t iflag) const;
+    void  Gdtom(Int_t n, const Double_t* xd, Double_t* xm, Int_t iflag) const;
+
   private:
     /// Not implemented
     TGeant4();
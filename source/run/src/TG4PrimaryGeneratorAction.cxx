@@ -18,6 +18,7 @@
 #include "TG4TrackManager.h"
 #include "TG4StateManager.h"
 #include "TG4UserIon.h"
+#include "TG4CallbackTimer.h"
 #include "TG4G3Units.h"
 #include "TG4Globals.h"
 
@@ -186,14 +187,24 @@ void TG4PrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
 
   // Begin of event
   TG4StateManager::Instance()->SetNewState(kInEvent);
-  mcApplication->BeginEvent();
+  {
+#ifdef USE_CALLBACK_TIMING
+    TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kBeginEvent);
+#endif
+    mcApplication->BeginEvent();
+  }
 
   // Update cached pointer to MC stack which is set to MC in some application
   // only in MCApplication::BeginEvent()
   TG4RunManager::Instance()->CacheMCStack();
 
   // Generate primaries and fill the VMC stack
-  mcApplication->GeneratePrimaries();
+  {
+#ifdef USE_CALLBACK_TIMING
+    TG4CallbackTimer::Guard timerGuard(TG4CallbackTimer::kGeneratePrimaries);
+#endif
+    mcApplication->GeneratePrimaries();
+  }
   
   // Transform Root particle objects to G4 objects
   TransformPrimaries(event);
@@ -20,11 +20,20 @@
 #include "TGeant4.h"
 #include "TG4Globals.h"
 #include "TG4RegionsManager.h"
+#include "TG4SteppingAction.h"
+#include "TG4StepProfiler.h"
+#include "TG4CallbackTimer.h"
+#include "TG4RussianRoulette.h"
+#include "TG4MemoryStatistics.h"
+#ifdef USE_G4ROOT
+#include <TG4RootNavMgr.h>
+#endif
 
 #include <G4Run.hh>
 #include <Randomize.hh>
 #include <G4UImanager.hh>
 #include "G4AutoLock.hh"
+#include <G4Threading.hh>
 
 #include <TObjArray.h>
 
@@ -136,10 +145,67 @@ void TG4RunAction::EndOfRunAction(const G4Run* run)
     fCrossSectionManager.MakeHistograms();
   }  
 
+  // Merge step profiling data and report them on master
+  if ( TG4StepProfiler::IsActive() ) {
+    if ( TG4SteppingAction::Instance() ) {
+      TG4SteppingAction::Instance()->GetStepProfiler().Merge();
+    }
+    if ( ! G4Threading::IsWorkerThread() ) {
+      TG4StepProfiler::PrintReport();
+      TG4StepProfiler::WriteTable();
+    }
+  }
+
+  // Merge Russian roulette statistics and report them on master
+  if ( TG4RussianRoulette::Instance() ) {
+    TG4RussianRoulette::Instance()->Merge();
+    if ( ! G4Threading::IsWorkerThread() ) {
+      TG4RussianRoulette::PrintStatistics();
+      TG4RussianRoulette::ClearStatistics();
+    }
+  }
+
+  // Merge memory high-water marks and report them on master
+  if ( TG4MemoryStatistics::Instance() ) {
+    TG4MemoryStatistics::Instance()->Merge();
+  }
+  if ( ! G4Threading::IsWorkerThread() ) {
+    TG4MemoryStatistics::PrintMerged();
+    TG4MemoryStatistics::ClearMerged();
+  }
+
+#ifdef USE_G4ROOT
+  // Merge G4Root navigation statistics and report them on master
+  TG4RootNavMgr* rootNavMgr = TG4RootNavMgr::GetInstance();
+  if ( rootNavMgr ) {
+    rootNavMgr->MergeStatistics();
+    if ( ! G4Threading::IsWorkerThread() ) {
+      if ( VerboseLevel() > 0 ) {
+        rootNavMgr->PrintG4State();
+      }
+      TG4RootNavMgr::CheckMergedStatistics();
+      TG4RootNavMgr::ClearMergedStatistics();
+    }
+  }
+#endif
+
   fTimer->Stop();
 
   if (VerboseLevel() > 0) {
     G4cout << "Time of this run:   " << *fTimer << G4endl;
     G4cout << "Number of events processed: " << run->GetNumberOfEvent() << G4endl;
   }    
+
+#ifdef USE_CALLBACK_TIMING
+  // Merge user callbacks timing and report it on master
+  TG4CallbackTimer::Merge();
+  if ( ! G4Threading::IsWorkerThread() ) {
+    if ( VerboseLevel() > 0 ) {
+      TG4CallbackTimer::Print(fTimer->GetRealElapsed());
+    }
+    else {
+      TG4CallbackTimer::Clear();
+    }
+  }
+#endif
 }    
@@ -444,6 +444,7 @@ void TG4RunManager::LateInitialize()
   // activate/inactivate physics processes
   TG4PhysicsManager::Instance()->SetProcessActivation();
   TG4PhysicsManager::Instance()->RetrieveOpBoundaryProcess();
+  TG4PhysicsManager::Instance()->CacheProcesses();
 
   // late initialize step manager
   TG4StepManager::Instance()->LateInitialize();
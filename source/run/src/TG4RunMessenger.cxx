@@ -16,11 +16,17 @@
 #include "TG4RunManager.h"
 #include "TG4Globals.h"
 #include "TG4UICmdWithAComplexString.h"
+#include "TG4StepProfiler.h"
+#ifdef USE_G4ROOT
+#include <TG4RootNavigator.h>
+#endif
 
 #include <G4UIdirectory.hh>
 #include <G4UIcmdWithoutParameter.hh>
 #include <G4UIcmdWithAString.hh>
 #include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithAnInteger.hh>
+#include <G4UIcmdWithADouble.hh>
 
 //_____________________________________________________________________________
 TG4RunMessenger::TG4RunMessenger(TG4RunManager* runManager)
@@ -31,7 +37,15 @@ TG4RunMessenger::TG4RunMessenger(TG4RunManager* runManager)
     fRootMacroCmd(0),  
     fRootCommandCmd(0),
     fUseRootRandomCmd(0),
-    fG3DefaultsCmd(0)
+    fG3DefaultsCmd(0),
+    fStepProfilingCmd(0),
+    fStepProfilingSamplingCmd(0),
+    fStepProfilingNofTopCmd(0),
+    fStepProfilingOutputCmd(0),
+    fClearStepProfilingCmd(0),
+    fG4RootSafetyReuseCmd(0),
+    fG4RootSafetyReuseFractionCmd(0),
+    fG4RootSafetyCheckCmd(0)
 { 
 /// Standard constructor
 
@@ -66,6 +80,80 @@ TG4RunMessenger::TG4RunMessenger(TG4RunManager* runManager)
   fG3DefaultsCmd->SetGuidance("Set G3 default parameters (cut values,");
   fG3DefaultsCmd->SetGuidance("tracking media max step values, ...)");
   fG3DefaultsCmd->AvailableForStates(G4State_PreInit);
+
+  fStepProfilingCmd = new G4UIcmdWithABool("/mcControl/setStepProfiling", this);
+  fStepProfilingCmd
+    ->SetGuidance("(In)Activate counting steps and time per volume, particle and process.");
+  fStepProfilingCmd->SetGuidance("The report is printed at the end of run.");
+  fStepProfilingCmd->SetParameterName("StepProfiling", true);
+  fStepProfilingCmd->SetDefaultValue(true);
+  fStepProfilingCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fStepProfilingSamplingCmd 
+    = new G4UIcmdWithAnInteger("/mcControl/setStepProfilingSampling", this);
+  fStepProfilingSamplingCmd
+    ->SetGuidance("Measure the time only for each N-th step.");
+  fStepProfilingSamplingCmd->SetParameterName("Sampling", false);
+  fStepProfilingSamplingCmd->SetRange("Sampling >= 1");
+  fStepProfilingSamplingCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fStepProfilingNofTopCmd 
+    = new G4UIcmdWithAnInteger("/mcControl/setStepProfilingNofTop", this);
+  fStepProfilingNofTopCmd
+    ->SetGuidance("Set the number of entries printed in the step profiling report.");
+  fStepProfilingNofTopCmd->SetParameterName("NofTop", false);
+  fStepProfilingNofTopCmd->SetRange("NofTop >= 0");
+  fStepProfilingNofTopCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fStepProfilingOutputCmd 
+    = new G4UIcmdWithAString("/mcControl/setStepProfilingOutput", this);
+  fStepProfilingOutputCmd
+    ->SetGuidance("Set the CSV file name for the step profiling table.");
+  fStepProfilingOutputCmd->SetParameterName("FileName", false);
+  fStepProfilingOutputCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fClearStepProfilingCmd 
+    = new G4UIcmdWithoutParameter("/mcControl/clearStepProfiling", this);
+  fClearStepProfilingCmd
+    ->SetGuidance("Clear the step profiling data accumulated in previous runs.");
+  fClearStepProfilingCmd->AvailableForStates(G4State_Idle);
+
+#ifdef USE_G4ROOT
+  fG4RootSafetyReuseCmd 
+    = new G4UIcmdWithABool("/mcControl/setG4RootSafetyReuse", this);
+  fG4RootSafetyReuseCmd
+    ->SetGuidance("(In)Activate reusing the last safety sphere in G4Root navigation:");
+  fG4RootSafetyReuseCmd
+    ->SetGuidance("inside the sphere the safety is estimated as the last safety");
+  fG4RootSafetyReuseCmd
+    ->SetGuidance("minus the distance from the sphere origin.");
+  fG4RootSafetyReuseCmd
+    ->SetGuidance("Off by default, it can be validated with /mcControl/setG4RootSafetyCheck.");
+  fG4RootSafetyReuseCmd->SetParameterName("SafetyReuse", true);
+  fG4RootSafetyReuseCmd->SetDefaultValue(true);
+  fG4RootSafetyReuseCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fG4RootSafetyReuseFractionCmd 
+    = new G4UIcmdWithADouble("/mcControl/setG4RootSafetyReuseFraction", this);
+  fG4RootSafetyReuseFractionCmd
+    ->SetGuidance("Set the fraction of the last safety below which the safety");
+  fG4RootSafetyReuseFractionCmd
+    ->SetGuidance("estimated from the safety sphere is recomputed.");
+  fG4RootSafetyReuseFractionCmd->SetParameterName("Fraction", false);
+  fG4RootSafetyReuseFractionCmd->SetRange("Fraction >= 0. && Fraction <= 1.");
+  fG4RootSafetyReuseFractionCmd
+    ->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fG4RootSafetyCheckCmd 
+    = new G4UIcmdWithABool("/mcControl/setG4RootSafetyCheck", this);
+  fG4RootSafetyCheckCmd
+    ->SetGuidance("(In)Activate validating the safety estimated from the safety sphere");
+  fG4RootSafetyCheckCmd
+    ->SetGuidance("against the full computation (for testing).");
+  fG4RootSafetyCheckCmd->SetParameterName("SafetyCheck", true);
+  fG4RootSafetyCheckCmd->SetDefaultValue(true);
+  fG4RootSafetyCheckCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+#endif
 }
 
 //_____________________________________________________________________________
@@ -79,6 +167,14 @@ TG4RunMessenger::~TG4RunMessenger()
   delete fRootCommandCmd;
   delete fUseRootRandomCmd;
   delete fG3DefaultsCmd;
+  delete fStepProfilingCmd;
+  delete fStepProfilingSamplingCmd;
+  delete fStepProfilingNofTopCmd;
+  delete fStepProfilingOutputCmd;
+  delete fClearStepProfilingCmd;
+  delete fG4RootSafetyReuseCmd;
+  delete fG4RootSafetyReuseFractionCmd;
+  delete fG4RootSafetyCheckCmd;
 }
 
 //
@@ -105,4 +201,34 @@ void TG4RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
   else if (command == fG3DefaultsCmd) {
     fRunManager->UseG3Defaults(); 
   }
+  else if (command == fStepProfilingCmd) {  
+    TG4StepProfiler::SetIsActive(fStepProfilingCmd->GetNewBoolValue(newValue)); 
+  }
+  else if (command == fStepProfilingSamplingCmd) {  
+    TG4StepProfiler::SetSampling(
+      fStepProfilingSamplingCmd->GetNewIntValue(newValue)); 
+  }
+  else if (command == fStepProfilingNofTopCmd) {  
+    TG4StepProfiler::SetNofTop(fStepProfilingNofTopCmd->GetNewIntValue(newValue)); 
+  }
+  else if (command == fStepProfilingOutputCmd) {  
+    TG4StepProfiler::SetOutputFileName(newValue); 
+  }
+  else if (command == fClearStepProfilingCmd) {  
+    TG4StepProfiler::ClearMerged(); 
+  }
+#ifdef USE_G4ROOT
+  else if (command == fG4RootSafetyReuseCmd) {  
+    TG4RootNavigator::SetSafetyReuse(
+      fG4RootSafetyReuseCmd->GetNewBoolValue(newValue)); 
+  }
+  else if (command == fG4RootSafetyReuseFractionCmd) {  
+    TG4RootNavigator::SetSafetyReuseFraction(
+      fG4RootSafetyReuseFractionCmd->GetNewDoubleValue(newValue)); 
+  }
+  else if (command == fG4RootSafetyCheckCmd) {  
+    TG4RootNavigator::SetSafetyCheck(
+      fG4RootSafetyCheckCmd->GetNewBoolValue(newValue)); 
+  }
+#endif
 }
@@ -1264,6 +1264,15 @@ Bool_t  TGeant4::IsCollectTracks() const
   return fStepManager->IsCollectTracks();
 }  
 
+//_____________________________________________________________________________
+void TGeant4::SetStepRecordNofLevels(Int_t nofLevels)
+{
+/// Set the number of volume levels (the current volume and its mothers)
+/// filled in the step record
+
+  TG4StepManager::SetStepRecordNofLevels(nofLevels);
+}
+
 //_____________________________________________________________________________
 void TGeant4::StartGeantUI() 
 {